@@ -42,19 +42,21 @@ class ArgContext(Context):
         return bugs
 
 class ArgChecker(Checker):
+    per_path = False
+
     def _initialize_process(self):
         self.context = ArgContext()
 
-    def _process_path(self, path):
-        for i, node in enumerate(path):
-            if is_call(node):
-                call = node.event.call
-                code = node.event.code
-                for i, arg1 in enumerate(call.args):
-                    for j in range(i + 1, len(call.args)):
-                        arg2 = call.args[j]
-                        related = check_related(arg1, arg2)
-                        self.context.add((call.name, i, j), related, code)
+    def _enter_node(self, path):
+        node = path[-1]
+        if is_call(node) and self.suffixes.reaches_eop(node):
+            call = node.event.call
+            code = node.event.code
+            for i, arg1 in enumerate(call.args):
+                for j in range(i + 1, len(call.args)):
+                    arg2 = call.args[j]
+                    related = check_related(arg1, arg2)
+                    self.context.add((call.name, i, j), related, code)
 
     def _finalize_process(self):
         return self.context
@@ -27,28 +27,25 @@ class CausalityContext(Context):
             self.add(key, None, code)
 
 class CausalityChecker(Checker):
+    per_path = False
+
     def _initialize_process(self):
         self.context = CausalityContext()
 
-    def _process_path(self, path):
-        # get latest manager
-        cmgr = path[-1].cmgr
-        for i, node in enumerate(path):
-            if is_call(node):
-                call = node.event.call
-                code = node.event.code
-                constraint = cmgr.get(call)
-                # want to use as dictionary key
-                if constraint is not None:
-                    constraint = tuple(constraint)
+    def _get_symbols(self, node):
+        return (node.event.call,) if is_call(node) else ()
 
-                calls = set()
-                for j in range(i + 1, len(path)):
-                    ff_node = path[j]
-                    if (is_call(ff_node)
-                            and ff_node.event.call.name != call.name):
-                        calls.add(ff_node.event.call.name)
-                self.context.add_or_intersect((call.name, constraint), calls, code)
+    def _enter_node(self, path):
+        node = path[-1]
+        if is_call(node):
+            call = node.event.call
+            code = node.event.code
+            # the calls that follow on every path, by the constraint the
+            # call ends with
+            finals = self._get_final_constraints(node, call)
+            for constraint, calls in finals.items():
+                self.context.add_or_intersect((call.name, constraint),
+                                              calls - {call.name}, code)
 
     def _finalize_process(self):
         self.context.add_all()
@@ -1,6 +1,7 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
-from ..parse.explorer import is_eop
+from ..parse.explorer import is_call, is_eop, is_truncated, get_constraint
+from ..parse.explorer import ConstraintMgr
 from ..lib import config
 from ..lib.store import Store
 
@@ -45,7 +46,136 @@ class Context():
                         bugs.append(br)
         return bugs
 
+class Suffixes(object):
+    # what the paths from a node to the EOPs below it have in common,
+    # computed bottom-up once per node of a tree, shared nodes included
+    def __init__(self, get_symbols):
+        self.get_symbols = get_symbols
+        self.calls = {}
+        self.assumed = {}
+        self.used = {}
+        self.firsts = {}
+
+    def _evaluate(self, memo, node, compute, is_leaf=None):
+        # memo[n] = compute(n) for node and the nodes below it, children
+        # first unless is_leaf(n)
+        stack = [node]
+        while stack:
+            top = stack[-1]
+            if top not in memo:
+                pending = []
+                if is_leaf is None or not is_leaf(top):
+                    pending = [child for child in top.children
+                               if child not in memo]
+                if pending:
+                    stack.extend(pending)
+                    continue
+                memo[top] = compute(top)
+            stack.pop()
+        return memo[node]
+
+    def get_calls(self, node):
+        # names of the calls on every path from node to an EOP, or None if
+        # there is no such path
+        if node in self.calls:
+            return self.calls[node]
+        return self._evaluate(self.calls, node, self._compute_calls)
+
+    def _compute_calls(self, node):
+        if is_eop(node):
+            return frozenset()
+        calls = None
+        for child in node.children:
+            below = self.calls[child]
+            if below is not None:
+                calls = below if calls is None else calls & below
+        if calls is not None and is_call(node):
+            name = node.event.call.name
+            if name not in calls:
+                calls = calls | {name}
+        return calls
+
+    def reaches_eop(self, node):
+        return self.get_calls(node) is not None
+
+    def _compute_symbols(self, memo, node, own):
+        symbols = frozenset()
+        for child in node.children:
+            below = memo[child]
+            if not below <= symbols:
+                symbols = below if not symbols else symbols | below
+        if not own <= symbols:
+            symbols = symbols | own
+        return symbols
+
+    def get_assumed(self, node):
+        # symbols constrained at or below node
+        if node in self.assumed:
+            return self.assumed[node]
+
+        def compute(node):
+            cond = get_constraint(node)
+            own = frozenset() if cond is None else frozenset([cond.symbol])
+            return self._compute_symbols(self.assumed, node, own)
+        return self._evaluate(self.assumed, node, compute)
+
+    def get_used(self, node):
+        # symbols the checker looks up at or below node
+        if node in self.used:
+            return self.used[node]
+
+        def compute(node):
+            own = frozenset(self.get_symbols(node))
+            return self._compute_symbols(self.used, node, own)
+        return self._evaluate(self.used, node, compute)
+
+    def get_firsts(self, node, sym):
+        # {constraints: calls} of the paths from node to an EOP, by the
+        # constraints sym is first given on them (a tuple, or None), with the
+        # names of the calls on every such path
+        if sym not in self.get_assumed(node):
+            calls = self.get_calls(node)
+            return {} if calls is None else {None: calls}
+        memo = self.firsts.setdefault(sym, {})
+        if node in memo:
+            return memo[node]
+        return self._evaluate(memo,
+                              node,
+                              lambda n: self._compute_firsts(memo, n, sym),
+                              lambda n: sym not in self.get_assumed(n))
+
+    def _compute_firsts(self, memo, node, sym):
+        if sym not in self.get_assumed(node):
+            calls = self.get_calls(node)
+            return {} if calls is None else {None: calls}
+        firsts = {}
+        for child in node.children:
+            for cstr, calls in memo[child].items():
+                if cstr in firsts:
+                    calls = firsts[cstr] & calls
+                firsts[cstr] = calls
+        cond = get_constraint(node)
+        if cond is not None and cond.symbol == sym and firsts:
+            # the first on all of them
+            calls = None
+            for below in firsts.values():
+                calls = below if calls is None else calls & below
+            return {tuple(cond.constraints): calls}
+        if is_call(node):
+            name = node.event.call.name
+            firsts = {cstr: calls if name in calls else calls | {name}
+                      for cstr, calls in firsts.items()}
+        return firsts
+
 class Checker(object):
+    # checkers visit the paths of a tree as a depth-first walk: nodes are
+    # entered and left, and the EOP of every path is reached, with
+    # self.suffixes to look below the current node.
+    # unless a checker needs every path, what it does below a node may only
+    # depend on the constraints its prefix gives the symbols of
+    # _get_symbols(), and the node is entered once per such constraints
+    per_path = True
+
     def _initialize_process(self):
         # optional
         pass
@@ -53,34 +183,95 @@ class Checker(object):
     def _finalize_process(self):
         raise NotImplementedError
 
-    def _process_path(self, path):
-        raise NotImplementedError
+    def _enter_node(self, path):
+        # optional: path[-1] is entered, path[-1].cmgr has the constraints
+        # of its prefix
+        pass
+
+    def _leave_node(self, path):
+        # optional
+        pass
+
+    def _at_eop(self, path):
+        # optional: path[-1] is an EOP
+        pass
+
+    def _at_truncated(self, path):
+        # optional: a path cut by an analysis budget is incomplete evidence,
+        # so it is not counted unless a checker wants it
+        pass
+
+    def _get_symbols(self, node):
+        # optional: the symbols whose constraints are looked up at node
+        return ()
+
+    def _get_final_constraints(self, node, sym):
+        # {constraints: calls} as Suffixes.get_firsts(), of the paths from
+        # the root through the entered node to an EOP: the constraints are
+        # path[-1].cmgr.get(sym, True) at their EOPs
+        cstr = node.cmgr.get(sym, True)
+        if cstr is None:
+            return self.suffixes.get_firsts(node, sym)
+        calls = self.suffixes.get_calls(node)
+        return {} if calls is None else {cstr: calls}
 
     def process(self, tree):
         self._initialize_process()
         self._do_dfs(tree)
         return self._finalize_process()
 
+    def _get_prefix(self, node, cmgr):
+        # what of cmgr the walk below node depends on
+        used = self.suffixes.get_used(node)
+        if len(cmgr) < len(used):
+            return frozenset((sym, tuple(cstr))
+                             for sym, cstr in cmgr.items() if sym in used)
+        prefix = []
+        for sym in used:
+            cstr = cmgr.get(sym, True)
+            if cstr is not None:
+                prefix.append((sym, cstr))
+        return frozenset(prefix)
+
     def _do_dfs(self, tree):
-        count = 0
-        indices = [0]
-        nodes = [tree.root]
+        self.suffixes = Suffixes(self._get_symbols)
+        # node -> the cmgr it was first entered with, then the set of
+        # prefixes it was entered with once it is shared
+        entered = {}
+        path = []
+        # nodes can be shared between paths, so constraints are
+        # (re)assigned along the path being visited; None leaves path[-1]
+        nodes = [(tree.root, ConstraintMgr())]
 
         while nodes:
-            index = indices.pop()
-            node = nodes.pop()
+            node, cmgr = nodes.pop()
+            if node is None:
+                self._leave_node(path)
+                path.pop()
+                continue
+            if not self.per_path:
+                prefixes = entered.get(node)
+                if prefixes is None:
+                    entered[node] = cmgr
+                else:
+                    if not isinstance(prefixes, set):
+                        prefixes = entered[node] = {
+                            self._get_prefix(node, prefixes)}
+                    prefix = self._get_prefix(node, cmgr)
+                    if prefix in prefixes:
+                        continue
+                    prefixes.add(prefix)
+
+            node.cmgr = cmgr
+            node.visited = False
+            path.append(node)
+            self._enter_node(path)
+            nodes.append((None, None))
             if is_eop(node):
-                nodes.append(node)
-                # delayed visiting for truncated paths
-                self._process_path(nodes)
-                nodes.pop()
-                count += 1
+                self._at_eop(path)
+            elif is_truncated(node):
+                self._at_truncated(path)
             else:
-                if len(node.children) > index:
-                    indices.append(index + 1)
-                    nodes.append(node)
-
-                    child = node.children[index]
-                    child.visited = False
-                    indices.append(0)
-                    nodes.append(child)
+                cmgr = node.cmgr.feed(node) or node.cmgr
+                for child in reversed(node.children):
+                    nodes.append((child, cmgr))
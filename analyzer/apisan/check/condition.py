@@ -1,5 +1,6 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
+from collections import Counter
 from .checker import Checker, Context
 from ..lib import utils, rank_utils
 from ..lib.rank_utils import (
@@ -9,27 +10,36 @@ from ..parse.explorer import is_call
 from ..parse.symbol import IDSymbol
 
 class CondChecker(Checker):
+    # pairs of calls are counted with the constraints both end with, which
+    # depend on the whole path
     def _initialize_process(self):
         self.context = Context()
+        self.calls = []
 
-    def _process_path(self, path):
+    def _enter_node(self, path):
+        if is_call(path[-1]):
+            self.calls.append(path[-1])
+
+    def _leave_node(self, path):
+        if is_call(path[-1]):
+            self.calls.pop()
+
+    def _at_eop(self, path):
         # get latest manager
         cmgr = path[-1].cmgr
-        for i, node in enumerate(path):
-            if is_call(node):
-                call = node.event.call
-                code = node.event.code
-                cstr = cmgr.get(call, True)
-                # want to use as dictionary key
-                constraints = set()
-                for j in range(0, len(path)):
-                    if i == j: # skip myself
-                        continue
-                    ff_node = path[j]
-                    if is_call(ff_node):
-                        ff_call = ff_node.event.call
-                        other_cstr = cmgr.get(ff_call, True)
-                        self.context.add((call.name, cstr), (ff_call.name, other_cstr), code)
+        keys = set()
+        counts = Counter()
+        for node in self.calls:
+            call = node.event.call
+            key = (call.name, cmgr.get(call, True))
+            keys.add((key, node.event.code))
+            counts[key] += 1
+        # every call is paired with the others on the path, itself only
+        # if it is there twice
+        for key, code in keys:
+            for other in counts:
+                if other != key or counts[key] > 1:
+                    self.context.add(key, other, code)
 
     def _finalize_process(self):
         return self.context
@@ -39,23 +39,25 @@ class FSBContext(Context):
         return bugs
 
 class FSBChecker(Checker):
+    per_path = False
+
     def _initialize_process(self):
         self.context = FSBContext()
 
-    def _process_path(self, path):
-        for i, node in enumerate(path):
-            if is_call(node):
-                call = node.event.call
-                code = node.event.code
-                for i, arg in enumerate(call.args):
-                    key = (call.name, i)
-                    value = (False, False)
-                    if isinstance(arg, StringLiteralSymbol):
-                        if is_format_string(arg.string):
-                            value = (True, True)
-                        else:
-                            value = (True, False)
-                    self.context.add(key, value, code)
+    def _enter_node(self, path):
+        node = path[-1]
+        if is_call(node) and self.suffixes.reaches_eop(node):
+            call = node.event.call
+            code = node.event.code
+            for i, arg in enumerate(call.args):
+                key = (call.name, i)
+                value = (False, False)
+                if isinstance(arg, StringLiteralSymbol):
+                    if is_format_string(arg.string):
+                        value = (True, True)
+                    else:
+                        value = (True, False)
+                self.context.add(key, value, code)
 
     def _finalize_process(self):
         return self.context
@@ -57,6 +57,23 @@ def check_integer_overflow(arg, cmgr, limit=INT_LIMIT):
         # missing check
         return IntOvflChkType.Missing
 
+class FinalConstraints(object):
+    # a ConstraintMgr for check_integer_overflow(), which looks up one
+    # symbol: the constraints it ends with on a path
+    def __init__(self, constraints=None):
+        self.constraints = constraints
+        self.symbol = None
+
+    def get(self, sym):
+        self.symbol = sym
+        return self.constraints
+
+def get_operand(arg):
+    # the symbol check_integer_overflow() looks up for arg, if any
+    cmgr = FinalConstraints()
+    check_integer_overflow(arg, cmgr)
+    return cmgr.symbol
+
 def count_corrects(value):
     count = 0
     for ctx, codes in value.items():
@@ -90,19 +107,42 @@ class IntOvflChecker(Checker):
     #       then check with this rule
     #       if x + c -> x >= 0 && x < UINT_MAX - c
     #       if x * c -> x < UINT_MAX / c
-    def _process_path(self, path):
-        cmgr = path[-1].cmgr
-        for i, node in enumerate(path):
-            if is_call(node):
-                call = node.event.call
-                code = node.event.code
-
-                for j, arg in enumerate(call.args):
-                    if isinstance(arg, BinaryOperatorSymbol):
-                        ret = check_integer_overflow(arg, cmgr)
+    per_path = False
+
+    def _enter_node(self, path):
+        node = path[-1]
+        if is_call(node):
+            call = node.event.call
+            code = node.event.code
+
+            for j, arg in enumerate(call.args):
+                if isinstance(arg, BinaryOperatorSymbol):
+                    for ret in self._check_paths(node, arg):
                         if ret != IntOvflChkType.Undefined:
                             self.context.add((call.name, j), ret, code)
 
+    def _get_symbols(self, node):
+        symbols = []
+        if is_call(node):
+            for arg in node.event.call.args:
+                if isinstance(arg, BinaryOperatorSymbol):
+                    operand = get_operand(arg)
+                    if operand is not None:
+                        symbols.append(operand)
+        return symbols
+
+    def _check_paths(self, node, arg):
+        # check_integer_overflow() of arg at the EOPs of the paths through
+        # node, which differ only in the constraints of its operand
+        operand = get_operand(arg)
+        if operand is None:
+            if not self.suffixes.reaches_eop(node):
+                return set()
+            return {check_integer_overflow(arg, FinalConstraints())}
+        finals = self._get_final_constraints(node, operand)
+        return {check_integer_overflow(arg, FinalConstraints(constraints))
+                for constraints in finals}
+
     def _initialize_process(self):
         self.context = IntOvflContext()
 
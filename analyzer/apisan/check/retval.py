@@ -3,7 +3,7 @@
 import copy
 from .checker import Checker, Context, BugReport
 from ..lib import rank_utils, config
-from ..parse.explorer import is_call
+from ..parse.explorer import is_call, is_eop
 from ..parse.symbol import IDSymbol
 
 class RetValContext(Context):
@@ -32,24 +32,29 @@ class RetValContext(Context):
 
 
 class RetValChecker(Checker):
+    per_path = False
+
     def _initialize_process(self):
         self.context = RetValContext()
 
-    def _process_path(self, path):
-        # get latest manager
-        cmgr = path[-1].cmgr
-        for i, node in enumerate(path):
-            if is_call(node):
-                call = node.event.call
-                code = node.event.code
-                constraint = cmgr.get(call)
-                # want to use as dictionary key
-                if constraint is None:
-                    # heuristic handling for wrapper function
-                    if i == len(path) - 2:
-                        continue
-                else:
-                    constraint = tuple(constraint)
+    def _get_symbols(self, node):
+        return (node.event.call,) if is_call(node) else ()
+
+    def _enter_node(self, path):
+        node = path[-1]
+        if is_call(node):
+            call = node.event.call
+            code = node.event.code
+            if node.cmgr.get(call) is None:
+                # heuristic handling for wrapper function: an unchecked
+                # call right before an EOP is not counted for that path
+                constraints = set()
+                for child in node.children:
+                    if not is_eop(child):
+                        constraints.update(self.suffixes.get_firsts(child, call))
+            else:
+                constraints = self._get_final_constraints(node, call)
+            for constraint in constraints:
                 self.context.add(call.name, constraint, code)
 
     def _finalize_process(self):
@@ -2,6 +2,7 @@
 #!/usr/bin/env python2
 import os
 import sys
+import json
 import pdb
 import glob
 
@@ -49,11 +50,40 @@ def read_file(pn):
         data = fd.read()
     return data
 
+MANIFEST = "manifest.jsonl"
+
+# records of the manifest written by the extractor, one per translation unit;
+# a source file analyzed again replaces its earlier record, even if its
+# options (and so its key) changed
+def read_manifest(out_d):
+    records = {}
+    with open(os.path.join(out_d, MANIFEST)) as fd:
+        for line in fd:
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                rec = json.loads(line)
+            except ValueError:
+                # a record cut short by a killed compiler
+                continue
+            records[rec.get("source", rec["key"])] = rec
+    return list(records.values())
+
 def get_files(out_d):
+    if os.path.exists(os.path.join(out_d, MANIFEST)):
+        for rec in read_manifest(out_d):
+            if rec.get("file"):
+                pn = os.path.join(out_d, rec["file"])
+                if os.path.exists(pn):
+                    yield pn
+        return
+
+    # databases from extractors without a manifest
     for root, dirs, files in os.walk(out_d):
         for name in files:
             pn = os.path.join(root, name)
-            if pn.endswith(".as"):
+            if pn.endswith(".as") or pn.endswith(".asb"):
                 yield pn
 
 def get_all_files(in_d):
@@ -0,0 +1,314 @@
+# SPDX-License-Identifier: MIT
+#!/usr/bin/env python3
+#
+# binary symbolic-context database (.asb)
+#
+# written by AsbWriter in SymExecExtractor; see SymExecDatabase.h for the
+# layout. all integers are unsigned LEB128 unless noted otherwise.
+#
+#   header  : "ASB" <version:u8>
+#   records : node records, children before parents
+#     CALL   : 0 <file> <line> <call> <#children> <child delta>...
+#     ASSUME : 1 <cond> <#children> <child delta>...
+#     EOP    : 2 <#children> <child delta>...
+#     TRUNC  : 3 <reason> <#children> <child delta>...
+#   footer  : <#strings> (<length> <bytes>)...
+#             <#functions> (<name> <#roots> <root offset>...
+#                           <#nodes> <time ms> <limits> <#frontier>)...
+#   trailer : <footer offset:u64 little endian> "ASB" <version:u8>
+#
+# version 1 has no TRUNC records and no budget figures (<#nodes>...).
+#
+# calls and conditions are structured <SYM> elements (see symbol.from_xml),
+# or C-like text in databases from older extractors.
+#
+import mmap
+import os
+import struct
+import xml.etree.ElementTree as ET
+
+from . import explorer, symbol
+from .event import CallEvent, EOPEvent, AssumeEvent, TruncatedEvent
+
+MAGIC = b"ASB"
+VERSION = 2
+VERSIONS = (1, 2)
+TRAILER = struct.Struct("<Q3sB")
+
+REC_CALL = 0
+REC_ASSUME = 1
+REC_EOP = 2
+REC_TRUNCATED = 3
+
+class AsbError(Exception):
+    pass
+
+def read_uleb128(buf, pos):
+    result = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        result |= (byte & 0x7f) << shift
+        if byte < 0x80:
+            return result, pos
+        shift += 7
+
+def encode_uleb128(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+def get_code(fn, line):
+    # same as <CODE> in xml
+    if line:
+        return "%s:%d" % (fn, line)
+    return fn
+
+def split_code(code):
+    fn, sep, line = code.rpartition(":")
+    if sep and line.isdigit():
+        return fn, int(line)
+    return code, 0
+
+class AsbReader(object):
+    def __init__(self, fn):
+        self.fn = fn
+        self.strings = []
+        self.functions = []
+        # offset -> ExecNode (shared nodes are built once)
+        self.nodes = {}
+        # string id -> Symbol or text
+        self.symbols = {}
+
+    def parse(self):
+        # return a list of ExecTree, one per path root
+        with open(self.fn, "rb") as f:
+            if os.fstat(f.fileno()).st_size < len(MAGIC) + 1 + TRAILER.size:
+                raise AsbError("truncated file")
+            self.buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        try:
+            self._read_footer()
+            forest = []
+            for name, roots, budget in self.functions:
+                for root in roots:
+                    forest.append(explorer.ExecTree(root=self._read_node(root),
+                                                    budget=budget))
+            return forest
+        except (IndexError, UnicodeDecodeError) as e:
+            raise AsbError("corrupted file: %s" % e)
+        finally:
+            self.buf.close()
+
+    def _read_footer(self):
+        buf = self.buf
+        if buf[:3] != MAGIC or buf[3] not in VERSIONS:
+            raise AsbError("bad header")
+        footer, magic, version = TRAILER.unpack_from(buf, len(buf) - TRAILER.size)
+        if magic != MAGIC or version != buf[3]:
+            raise AsbError("bad trailer")
+
+        pos = footer
+        count, pos = read_uleb128(buf, pos)
+        for i in range(count):
+            size, pos = read_uleb128(buf, pos)
+            self.strings.append(buf[pos:pos + size].decode("utf-8"))
+            pos += size
+
+        count, pos = read_uleb128(buf, pos)
+        for i in range(count):
+            name, pos = read_uleb128(buf, pos)
+            nroots, pos = read_uleb128(buf, pos)
+            roots = []
+            for j in range(nroots):
+                root, pos = read_uleb128(buf, pos)
+                roots.append(root)
+            budget = None
+            if version >= 2:
+                figures = []
+                for j in range(4):
+                    figure, pos = read_uleb128(buf, pos)
+                    figures.append(figure)
+                nodes, time, limits, frontier = figures
+                budget = explorer.Budget(
+                    nodes, time,
+                    [l for i, l in enumerate(explorer.LIMITS) if limits & (1 << i)],
+                    frontier)
+            self.functions.append((self.strings[name], roots, budget))
+
+    def _read_record(self, offset):
+        # return (kind, fields, child offsets)
+        buf = self.buf
+        kind, pos = read_uleb128(buf, offset)
+        if kind == REC_CALL:
+            nfields = 3
+        elif kind == REC_ASSUME:
+            nfields = 1
+        elif kind == REC_EOP:
+            nfields = 0
+        elif kind == REC_TRUNCATED:
+            nfields = 1
+        else:
+            raise AsbError("unknown record kind %d at %d" % (kind, offset))
+
+        fields = []
+        for i in range(nfields):
+            field, pos = read_uleb128(buf, pos)
+            fields.append(field)
+
+        nchildren, pos = read_uleb128(buf, pos)
+        children = []
+        for i in range(nchildren):
+            delta, pos = read_uleb128(buf, pos)
+            children.append(offset - delta)
+        return kind, fields, children
+
+    def _get_symbol(self, sid):
+        sym = self.symbols.get(sid)
+        if sym is None:
+            sym = self.strings[sid]
+            if sym.startswith("<SYM"):
+                sym = symbol.from_xml(ET.fromstring(sym))
+            self.symbols[sid] = sym
+        return sym
+
+    def _make_event(self, kind, fields):
+        strings = self.strings
+        if kind == REC_CALL:
+            fn, line, call = fields
+            return CallEvent(get_code(strings[fn], line), self._get_symbol(call))
+        elif kind == REC_ASSUME:
+            return AssumeEvent(self._get_symbol(fields[0]))
+        elif kind == REC_TRUNCATED:
+            return TruncatedEvent(strings[fields[0]])
+        else:
+            return EOPEvent()
+
+    def _read_node(self, offset):
+        # children are built before their parents, without recursion
+        nodes = self.nodes
+        stack = [(offset, None)]
+        while stack:
+            offset, record = stack.pop()
+            if offset in nodes:
+                continue
+            if record is None:
+                record = self._read_record(offset)
+                stack.append((offset, record))
+                for child in record[2]:
+                    if child not in nodes:
+                        stack.append((child, None))
+            else:
+                kind, fields, children = record
+                event = self._make_event(kind, fields)
+                nodes[offset] = explorer.ExecNode(
+                    event, [nodes[child] for child in children])
+        return nodes[offset]
+
+class AsbWriter(object):
+    # same as AsbWriter in SymExecDatabase.cpp
+    def __init__(self, f):
+        self.f = f
+        self.pos = 0
+        self.string_ids = {}
+        self.strings = []
+        self.offsets = []
+        self.functions = []
+        self._write(MAGIC + bytes([VERSION]))
+
+    def _write(self, data):
+        self.f.write(data)
+        self.pos += len(data)
+
+    def _intern(self, string):
+        sid = self.string_ids.get(string)
+        if sid is None:
+            sid = len(self.strings)
+            self.string_ids[string] = sid
+            self.strings.append(string)
+        return sid
+
+    def _add_record(self, kind, fields, children):
+        offset = self.pos
+        data = [encode_uleb128(kind)]
+        data += [encode_uleb128(field) for field in fields]
+        data.append(encode_uleb128(len(children)))
+        data += [encode_uleb128(offset - self.offsets[child])
+                 for child in children]
+        self._write(b"".join(data))
+        self.offsets.append(offset)
+        return len(self.offsets) - 1
+
+    def add_call(self, fn, line, call, children):
+        fields = [self._intern(fn), line, self._intern(call)]
+        return self._add_record(REC_CALL, fields, children)
+
+    def add_assume(self, cond, children):
+        return self._add_record(REC_ASSUME, [self._intern(cond)], children)
+
+    def add_eop(self, children):
+        return self._add_record(REC_EOP, [], children)
+
+    def add_truncated(self, reason, children):
+        return self._add_record(REC_TRUNCATED, [self._intern(reason)], children)
+
+    def add_function(self, name, roots, budget=None):
+        roots = [self.offsets[root] for root in roots]
+        self.functions.append((self._intern(name), roots, budget))
+        self.offsets = []
+
+    def finish(self):
+        footer = self.pos
+        data = [encode_uleb128(len(self.strings))]
+        for string in self.strings:
+            raw = string.encode("utf-8")
+            data += [encode_uleb128(len(raw)), raw]
+        data.append(encode_uleb128(len(self.functions)))
+        for name, roots, budget in self.functions:
+            data += [encode_uleb128(name), encode_uleb128(len(roots))]
+            data += [encode_uleb128(root) for root in roots]
+            if budget is None:
+                budget = explorer.Budget(0, 0, [], 0)
+            limits = sum(1 << explorer.LIMITS.index(l) for l in budget.limits)
+            data += [encode_uleb128(figure) for figure in
+                     (budget.nodes, budget.time, limits, budget.frontier)]
+        data.append(TRAILER.pack(footer, MAGIC, VERSION))
+        self._write(b"".join(data))
+
+def _get_field(xml):
+    # a structured symbol is kept as its xml
+    if len(xml):
+        return ET.tostring(xml[0], encoding="unicode")
+    return xml.text
+
+def _write_event(writer, xml, children):
+    # return the record index of a <NODE>, given its <EVENT> and the
+    # indices of its children
+    event = {child.tag: _get_field(child) for child in xml}
+    kind = event["KIND"]
+    if kind == "@LOG_CALL":
+        fn, line = split_code(event.get("CODE") or "")
+        return writer.add_call(fn, line, event.get("CALL") or "", children)
+    elif kind == "@LOG_ASSUME":
+        return writer.add_assume(event.get("COND") or "", children)
+    elif kind == "@LOG_EOP":
+        return writer.add_eop(children)
+    elif kind == "@LOG_TRUNCATED":
+        return writer.add_truncated(event.get("REASON") or "", children)
+    else:
+        raise ValueError("Unknown kind")
+
+def convert(in_fn, out_fn):
+    # convert an xml database file (.as) into .asb
+    with open(out_fn, "wb") as f:
+        writer = AsbWriter(f)
+        build = lambda event, children: _write_event(writer, event, children)
+        for roots, budget in explorer.iter_reports(in_fn, build):
+            writer.add_function("", roots, budget)
+        writer.finish()
@@ -1,8 +1,9 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
 from enum import Enum
-from .symbol import CallSymbol
-from .sparser import SParser
+from . import symbol
+from .symbol import CallSymbol, Symbol
+from .sparser import parse_symbol
 from ..lib import dbg
 
 gid = 0
@@ -12,6 +13,7 @@ class EventKind(Enum):
     Location = "@LOG_LOCATION"
     EOP = "@LOG_EOP"
     Assume = "@LOG_ASSUME"
+    Truncated = "@LOG_TRUNCATED"
 
 class Event(object):
     def __init__(self):
@@ -23,29 +25,40 @@ class Event(object):
         return self.id
 
     def _parse_symbol(self, string):
-        try:
-            parser = SParser()
-            sym = parser.parse(string)
-            return sym
-        except Exception as e:
-            #dbg.debug('Exception when parsing : %s' % e)
-            return
+        # structured symbols need no parsing; text is from older databases
+        if isinstance(string, Symbol):
+            return string
+        return parse_symbol(string)
+
+
+def _get_symbol(node):
+    # a <SYM> element, or C-like text to be parsed
+    for child in node:
+        if child.tag == "SYM":
+            return symbol.from_xml(child)
+    return node.text
 
 
 class CallEvent(Event):
-    def __init__(self, event):
+    def __init__(self, code, call):
         super().__init__()
         self.kind = EventKind.Call
+        self.code = code
+        self.call = self._parse_call(call)
 
+    @classmethod
+    def from_xml(cls, event):
+        code = call = None
         for child in event:
             if child.tag == "KIND":
-                assert child.text == self.kind.value
+                assert child.text == EventKind.Call.value
             elif child.tag == "CALL":
-                self.call = self._parse_call(child.text)
+                call = _get_symbol(child)
             elif child.tag == "CODE":
-                self.code = child.text
+                code = child.text
             else:
                 raise ValueError("Unknown tag for CallEvent")
+        return cls(code, call)
 
     def _parse_call(self, text):
         sym = self._parse_symbol(text)
@@ -53,50 +66,84 @@ class CallEvent(Event):
             return sym
 
 class LocationEvent(Event):
-    def __init__(self, event):
+    def __init__(self, code, loc, type):
         super().__init__()
         self.kind = EventKind.Location
+        self.code = code
+        self.loc = self._parse_symbol(loc)
+        self.type = type
 
+    @classmethod
+    def from_xml(cls, event):
+        code = loc = type = None
         for child in event:
             if child.tag == "KIND":
-                assert child.text == self.kind.value
+                assert child.text == EventKind.Location.value
             elif child.tag == "LOC":
-                self.loc = self._parse_symbol(child.text)
+                loc = child.text
             elif child.tag == "TYPE":
-                self.type = child.text
+                type = child.text
             elif child.tag == "CODE":
-                self.code = child.text
+                code = child.text
             else:
                 raise ValueError("Unknown tag for LocationEvent")
+        return cls(code, loc, type)
 
     def is_store(self):
         return self.type == "STORE"
 
 class EOPEvent(Event):
-    def __init__(self, event):
+    def __init__(self):
         super().__init__()
         self.kind = EventKind.EOP
 
+    @classmethod
+    def from_xml(cls, event):
         for child in event:
             if child.tag == "KIND":
-                assert child.text == self.kind.value
+                assert child.text == EventKind.EOP.value
             else:
                 raise ValueError("Unknown tag for EOPEvent")
+        return cls()
 
 class AssumeEvent(Event):
-    def __init__(self, event):
+    def __init__(self, cond):
         super().__init__()
         self.kind = EventKind.Assume
+        self.cond = self.parse_cond(cond)
 
+    @classmethod
+    def from_xml(cls, event):
+        cond = None
         for child in event:
             if child.tag == "KIND":
-                assert child.text == self.kind.value
+                assert child.text == EventKind.Assume.value
             elif child.tag == "COND":
-                self.cond = self.parse_cond(child.text)
+                cond = _get_symbol(child)
             else:
                 raise ValueError("Unknown tag for AssumeEvent")
+        return cls(cond)
 
     def parse_cond(self, cond):
         # XXX: symbol can be UnknownSymbol when parsing failed
         sym = self._parse_symbol(cond)
         return sym
+
+class TruncatedEvent(Event):
+    # the path was cut by an analysis budget (nodes, time, blocks, aborted)
+    def __init__(self, reason):
+        super().__init__()
+        self.kind = EventKind.Truncated
+        self.reason = reason
+
+    @classmethod
+    def from_xml(cls, event):
+        reason = None
+        for child in event:
+            if child.tag == "KIND":
+                assert child.text == EventKind.Truncated.value
+            elif child.tag == "REASON":
+                reason = child.text
+            else:
+                raise ValueError("Unknown tag for TruncatedEvent")
+        return cls(reason)
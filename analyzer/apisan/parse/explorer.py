@@ -1,6 +1,6 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
-import copy
+import collections
 import multiprocessing as mp
 import os
 import xml.etree.ElementTree as ET
@@ -8,99 +8,175 @@ import xml.etree.ElementTree as ET
 from ..lib import dbg
 from ..lib import utils
 from .event import EventKind, EOPEvent, CallEvent, LocationEvent, AssumeEvent
+from .event import TruncatedEvent
 from .symbol import SymbolKind
+from . import asb, native
 
 ROOT = os.path.dirname(__file__)
 SIG = "@SYM_EXEC_EXTRACTOR"
 
-def is_too_big(body):
-    # > 1GB
-    return len(body) / (2 ** 30) > 1
-
 def sig_begin():
     return SIG + "_BEGIN"
 
 def sig_end():
     return SIG + "_END"
 
+# budget figures of the analysis of a function (SymExecBudget): exploded
+# nodes, milliseconds (0 unless max-time was set), budgets hit and nodes
+# where paths were cut
+Budget = collections.namedtuple("Budget", ["nodes", "time", "limits", "frontier"])
+LIMITS = ["nodes", "time", "blocks", "aborted"]
+
+def get_budget(xml):
+    # from the attributes of <TREE>, or of the <BUDGET> that closes a
+    # streamed report, if the extractor wrote them
+    if xml.get("NODES") is None:
+        budget = xml.find("BUDGET")
+        if budget is None:
+            return None
+        xml = budget
+    limits = xml.get("LIMITS")
+    return Budget(int(xml.get("NODES")), int(xml.get("TIME", 0)),
+                  limits.split(",") if limits else [],
+                  int(xml.get("FRONTIER", 0)))
+
 def get_all_files(in_d):
     files = []
     for fn in utils.get_files(in_d):
         files.append(fn)
     return files
 
+# links a ConstraintMgr looks up before its table, see ConstraintMgr
+FLATTEN = 8
+
 class ConstraintMgr(object):
-    def __init__(self):
-        self.constraints = dict()
+    # the constraints given along a path, as a persistent map: feed() links
+    # a new manager to this one instead of copying it, and every FLATTEN
+    # links are folded into a table that the managers below share. a
+    # lookup reads at most FLATTEN links and one table. constraint lists
+    # are those of the ConstraintSymbols, and are not to be modified
+    __slots__ = ("parent", "symbol", "constraints", "links", "table", "size")
+
+    def __init__(self, parent=None, symbol=None, constraints=None):
+        self.parent = parent
+        self.symbol = symbol
+        self.constraints = constraints
+        if parent is None:
+            self.links = 0
+            self.table = {}
+            self.size = 0
+        elif parent.links + 1 < FLATTEN:
+            self.links = parent.links + 1
+            self.table = parent.table
+            self.size = parent.size + 1
+        else:
+            # fold this link and those of parent into a table of its own
+            table = dict(parent.table)
+            mgr = parent
+            for _ in range(parent.links):
+                table[mgr.symbol] = mgr.constraints
+                mgr = mgr.parent
+            table[symbol] = constraints
+            self.parent = None
+            self.links = 0
+            self.table = table
+            self.size = parent.size + 1
+
+    def _lookup(self, sym):
+        mgr = self
+        for _ in range(self.links):
+            if mgr.symbol == sym:
+                return mgr.constraints
+            mgr = mgr.parent
+        return self.table.get(sym, self)
 
     def feed(self, node):
         # return newly allocated ConstraintMgr if changed
         # otherwise return null
-        event = node.event
-        if event.kind == EventKind.Assume:
-            cond = event.cond
-            if cond and cond.kind == SymbolKind.Constraint:
-                # XXX : latest gives false positives
-                if not cond.symbol in self.constraints:
-                    new = copy.deepcopy(self)
-                    new.constraints[cond.symbol] = cond.constraints
-                    return new
+        cond = get_constraint(node)
+        # XXX : latest gives false positives
+        if cond is not None and self._lookup(cond.symbol) is self:
+            return ConstraintMgr(self, cond.symbol, cond.constraints)
+
+    def __len__(self):
+        return self.size
+
+    def items(self):
+        mgr = self
+        for _ in range(self.links):
+            yield mgr.symbol, mgr.constraints
+            mgr = mgr.parent
+        yield from self.table.items()
 
     def __repr__(self):
-        return "CM(%s)" % repr(self.constraints)
+        return "CM(%s)" % repr(dict(self.items()))
 
     def get(self, sym, immutable=False):
-        if sym in self.constraints:
-            cstr = self.constraints[sym]
-            if immutable:
-                return tuple(cstr)
-            else:
-                return cstr
-        return None
+        cstr = self._lookup(sym)
+        if cstr is self:
+            return None
+        if immutable:
+            return tuple(cstr)
+        else:
+            return cstr
 
 def is_eop(node):
     return (node.event is not None
             and isinstance(node.event, EOPEvent))
 
+def is_truncated(node):
+    return (node.event is not None
+            and isinstance(node.event, TruncatedEvent))
+
+def get_constraint(node):
+    # the ConstraintSymbol an assume node adds to a ConstraintMgr, or None
+    event = node.event
+    if event is not None and event.kind == EventKind.Assume:
+        cond = event.cond
+        if cond and cond.kind == SymbolKind.Constraint:
+            return cond
+    return None
+
 def is_call(node):
     return (node.event is not None
             and isinstance(node.event, CallEvent)
             and node.event.call is not None)
 
 class ExecNode(object):
-    def __init__(self, node, children):
-        assert node.tag == "NODE"
+    def __init__(self, event, children):
         self._set_children(children)
         self.parent = None
         self.visited = False
-        self.event = None
-
-        for child in node:
-            if child.tag == "EVENT":
-                assert self.event is None
-                self.event = self._parse_event(child)
-            elif child.tag == "NODE":
-                continue
-            else:
-                raise ValueError("Unknown tag")
-
-    def _parse_event(self, node):
+        self.event = event
+
+    @classmethod
+    def from_xml(cls, event, children):
+        # event is the <EVENT> of a <NODE>, or None if it had none
+        if event is not None:
+            event = cls._parse_event(event)
+        return cls(event, children)
+
+    @staticmethod
+    def _parse_event(node):
         kind = node[0]
         assert kind.tag == "KIND"
 
         if kind.text == "@LOG_CALL":
-            return CallEvent(node)
+            return CallEvent.from_xml(node)
         elif kind.text == "@LOG_LOCATION":
-            return LocationEvent(node)
+            return LocationEvent.from_xml(node)
         elif kind.text == "@LOG_EOP":
-            return EOPEvent(node)
+            return EOPEvent.from_xml(node)
         elif kind.text == "@LOG_ASSUME":
-            return AssumeEvent(node)
+            return AssumeEvent.from_xml(node)
+        elif kind.text == "@LOG_TRUNCATED":
+            return TruncatedEvent.from_xml(node)
         else:
             raise ValueError("Unknown kind")
 
     def _set_children(self, children):
         # set parent-child relation
+        # NOTE: in graph output, a shared node keeps its last parent
         self.children = children
         for child in children:
             child.parent = self
@@ -113,52 +189,10 @@ class ExecNode(object):
         return result
 
 class ExecTree(object):
-    def __init__(self, xml):
-        self.xml = xml
-
-    def parse(self):
-        self.root = self._parse()
-        self._set_cmgr()
-
-    def _set_cmgr(self):
-        stack = []
-        stack.append((self.root, 0))
-        self.root.cmgr = ConstraintMgr()
-
-        while stack:
-            node, idx = stack.pop()
-            if idx == len(node.children):
-                # base case : all childrens are visited
-                continue
-            else:
-                child = node.children[idx]
-                cmgr = node.cmgr.feed(node)
-                if cmgr:
-                    child.cmgr = cmgr
-                else:
-                    child.cmgr = node.cmgr
-
-                stack.append((node, idx + 1))
-                stack.append((child, 0))
-
-    def _parse(self):
-        stack = []
-        stack.append((self.xml, 0, []))
-
-        while True:
-            xml_node, idx, children = stack.pop()
-            # + 1 because of event
-            if len(xml_node) == idx + 1:
-                node = ExecNode(xml_node, children)
-                if not stack:
-                    return node
-                else:
-                    # children
-                    stack[-1][2].append(node)
-            else:
-                # increase stack & create new stack frame
-                stack.append((xml_node, idx + 1, children))
-                stack.append((xml_node[idx + 1], 0, []))
+    def __init__(self, root, budget=None):
+        self.root = root
+        # Budget of the function, None for older extractors
+        self.budget = budget
 
 class Explorer(object):
     def __init__(self, checker):
@@ -189,33 +223,106 @@ class Explorer(object):
         return self.checker.merge(result)
 
     def _parse_file(self, fn):
+        if fn.endswith(".asb"):
+            try:
+                return asb.AsbReader(fn).parse()
+            except asb.AsbError as e:
+                dbg.info("ERROR : %s when parsing %s" % (repr(e), fn))
+                return []
+
+        if native.is_available():
+            try:
+                return native.NativeDatabase(fn).parse()
+            except native.NativeError as e:
+                dbg.debug("%s: %s, read in Python" % (fn, e))
+
         forest = []
-        with open(fn, 'r') as f:
-            start = False
-            body = ""
-
-            for line in f:
-                if line.startswith(sig_begin()):
-                    start = True
-                    body = ""
-                elif start:
-                    if line.startswith(sig_end()):
-                        start = False
-
-                        # XXX: tooo large file cannot be handled
-                        if is_too_big(body):
-                            dbg.info("Ignore too large file : %s" % fn)
-                            continue
-                        try:
-                            xml = ET.fromstring(body)
-                        except Exception as e:
-                            dbg.info("ERROR : %s when parsing %s" % (repr(e), fn))
-                            return []
-
-                        for root in xml:
-                            tree = ExecTree(root)
-                            tree.parse()
-                            forest.append(tree)
-                    else:
-                        body += line
+        for roots, budget in iter_reports(fn, ExecNode.from_xml):
+            for root in roots:
+                forest.append(ExecTree(root, budget=budget))
         return forest
+
+class ReportReader(object):
+    # builds the nodes of one extractor report as their tags close: a
+    # <NODE> is handed to build() with its <EVENT> and the nodes of its
+    # children, then cleared, so only the elements of the open nodes are
+    # kept next to the nodes built so far
+    def __init__(self, fn, build):
+        self.fn = fn
+        self.build = build
+        self.parser = ET.XMLPullParser(events=("end",))
+        # nodes built from the closed <NODE>s of open elements
+        self.nodes = {}
+        # nodes emitted with an ID, shared by all trees of the report
+        self.shared = {}
+        self.report = None
+        self.failed = False
+
+    def feed(self, data):
+        self._parse(self.parser.feed, data)
+
+    def close(self):
+        # return the roots and the budget of the report, None if damaged
+        self._parse(self.parser.close)
+        return None if self.failed else self.report
+
+    def _parse(self, func, *args):
+        if self.failed:
+            return
+        try:
+            func(*args)
+            for _, elem in self.parser.read_events():
+                if elem.tag == "NODE":
+                    self._end_node(elem)
+                elif elem.tag == "TREE":
+                    self.report = (self._get_children(elem), get_budget(elem))
+                    elem.clear()
+        except ET.ParseError as e:
+            # a damaged report costs only its own functions
+            dbg.info("ERROR : %s when parsing %s" % (repr(e), self.fn))
+            self.failed = True
+            self.nodes = self.shared = None
+
+    def _end_node(self, elem):
+        event = elem.find("EVENT")
+        node = self.build(event, self._get_children(elem))
+        nid = elem.get("ID")
+        if nid is not None:
+            self.shared[nid] = node
+        self.nodes[elem] = node
+        elem.clear()
+
+    def _get_children(self, elem):
+        children = []
+        for child in elem:
+            if child.tag == "NODE":
+                children.append(self.nodes.pop(child))
+            elif child.tag == "REF":
+                # back-reference to an already emitted node
+                children.append(self.shared[child.get("ID")])
+        return children
+
+def iter_reports(fn, build):
+    # yield the roots and the budget of each extractor report in fn;
+    # build(event, children) makes a node of a <NODE>, see ReportReader
+    with open(fn, 'r') as f:
+        reader = None
+        chunk = []
+
+        for line in f:
+            if line.startswith(sig_begin()):
+                reader = ReportReader(fn, build)
+                chunk = []
+            elif reader is not None:
+                if line.startswith(sig_end()):
+                    reader.feed("".join(chunk))
+                    report = reader.close()
+                    reader = None
+                    if report is not None:
+                        yield report
+                else:
+                    # fed in blocks, the parser spends less per line
+                    chunk.append(line)
+                    if len(chunk) == 1024:
+                        reader.feed("".join(chunk))
+                        chunk = []
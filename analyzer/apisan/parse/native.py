@@ -0,0 +1,271 @@
+# SPDX-License-Identifier: MIT
+#!/usr/bin/env python3
+#
+# native reader of xml database files (.as)
+#
+# libApisanDB (llvm/tools/clang/tools/apisan-db) scans a file into arrays,
+# and NativeNode reads an ExecNode's fields from them when first asked.
+# files the library cannot read go through explorer.iter_reports().
+#
+import ctypes
+import os
+import xml.etree.ElementTree as ET
+
+from . import explorer
+from .event import CallEvent, EOPEvent, AssumeEvent, TruncatedEvent
+from .event import _get_symbol
+from .sparser import parse_symbol
+from .symbol import ConstraintSymbol, Symbol
+
+TOP = os.path.join(os.path.dirname(os.path.realpath(__file__)), "../../../")
+# an empty APISAN_DB_LIB turns the native reader off
+LIB = os.environ.get("APISAN_DB_LIB",
+                     os.path.join(TOP, "./bin/llvm/lib/libApisanDB.so"))
+
+NONE = 0xffffffff
+
+NODE_CALL = 0
+NODE_ASSUME = 1
+NODE_EOP = 2
+NODE_TRUNCATED = 3
+
+NODE_CONSTRAINT = 1
+
+RANGE_NEGATIVE_FROM = 1
+RANGE_NEGATIVE_TO = 2
+
+_u8 = ctypes.POINTER(ctypes.c_uint8)
+_u32 = ctypes.POINTER(ctypes.c_uint32)
+_u64 = ctypes.POINTER(ctypes.c_uint64)
+
+class _Arrays(ctypes.Structure):
+    # ApisanDBArrays
+    _fields_ = [("NumNodes", ctypes.c_uint32),
+                ("Kinds", _u8),
+                ("Flags", _u8),
+                ("Parents", _u32),
+                ("ChildStart", _u32),
+                ("Children", _u32),
+                ("Codes", _u32),
+                ("Texts", _u32),
+                ("RangeStart", _u32),
+                ("Ranges", _u64),
+                ("RangeSigns", _u8),
+                ("NumStrings", ctypes.c_uint32),
+                ("Base", ctypes.c_void_p),
+                ("StringOffsets", _u64),
+                ("StringSizes", _u32),
+                ("NumReports", ctypes.c_uint32),
+                ("RootStart", _u32),
+                ("Roots", _u32),
+                ("Budgets", _u64),
+                ("HasBudget", _u8)]
+
+def _load():
+    if not LIB:
+        return None
+    try:
+        lib = ctypes.CDLL(LIB)
+    except OSError:
+        return None
+    lib.apisan_db_open.argtypes = [ctypes.c_char_p]
+    lib.apisan_db_open.restype = ctypes.c_void_p
+    lib.apisan_db_get_error.argtypes = [ctypes.c_void_p]
+    lib.apisan_db_get_error.restype = ctypes.c_char_p
+    lib.apisan_db_get_arrays.argtypes = [ctypes.c_void_p]
+    lib.apisan_db_get_arrays.restype = ctypes.POINTER(_Arrays)
+    lib.apisan_db_close.argtypes = [ctypes.c_void_p]
+    lib.apisan_db_close.restype = None
+    return lib
+
+_lib = _load()
+
+def is_available():
+    return _lib is not None
+
+class NativeError(Exception):
+    pass
+
+def _get_text(elem):
+    return elem.text
+
+def _buffer(pointer, fmt, count):
+    # a buffer object over count items of a native array
+    if not count:
+        return memoryview(b"").cast(fmt)
+    size = count * ctypes.sizeof(pointer._type_)
+    array = (ctypes.c_char * size).from_address(
+        ctypes.cast(pointer, ctypes.c_void_p).value)
+    return memoryview(array).cast("B").cast(fmt)
+
+class NativeDatabase(object):
+    def __init__(self, fn):
+        self.handle = _lib.apisan_db_open(os.fsencode(fn))
+        error = _lib.apisan_db_get_error(self.handle)
+        if error is not None:
+            self.close()
+            raise NativeError(error.decode("utf-8", "replace"))
+
+        arrays = _lib.apisan_db_get_arrays(self.handle).contents
+        nodes = arrays.NumNodes
+        self.kinds = _buffer(arrays.Kinds, "B", nodes)
+        self.flags = _buffer(arrays.Flags, "B", nodes)
+        self.parents = _buffer(arrays.Parents, "I", nodes)
+        self.child_start = _buffer(arrays.ChildStart, "I", nodes + 1)
+        self.children = _buffer(arrays.Children, "I",
+                                self.child_start[nodes])
+        self.codes = _buffer(arrays.Codes, "I", nodes)
+        self.texts = _buffer(arrays.Texts, "I", nodes)
+        self.range_start = _buffer(arrays.RangeStart, "I", nodes + 1)
+        self.ranges = _buffer(arrays.Ranges, "Q", 2 * self.range_start[nodes])
+        self.range_signs = _buffer(arrays.RangeSigns, "B",
+                                   self.range_start[nodes])
+
+        self.base = arrays.Base
+        self.string_offsets = _buffer(arrays.StringOffsets, "Q",
+                                      arrays.NumStrings)
+        self.string_sizes = _buffer(arrays.StringSizes, "I", arrays.NumStrings)
+
+        reports = arrays.NumReports
+        self.root_start = _buffer(arrays.RootStart, "I", reports + 1)
+        self.roots = _buffer(arrays.Roots, "I", self.root_start[reports])
+        self.budgets = _buffer(arrays.Budgets, "Q", 4 * reports)
+        self.has_budget = _buffer(arrays.HasBudget, "B", reports)
+
+        # views, built once so that shared nodes are one object
+        self.nodes = [None] * nodes
+        # string id -> text or symbol, see _get_string()
+        self.text_cache = {}
+        self.symbol_cache = {}
+
+    def __del__(self):
+        self.close()
+
+    def close(self):
+        if self.handle is not None:
+            _lib.apisan_db_close(self.handle)
+            self.handle = None
+
+    def parse(self):
+        # return a list of ExecTree, one per path root
+        forest = []
+        for report in range(len(self.has_budget)):
+            budget = self._get_budget(report)
+            start, end = self.root_start[report], self.root_start[report + 1]
+            for root in self.roots[start:end]:
+                forest.append(explorer.ExecTree(self.get_node(root),
+                                                budget=budget))
+        return forest
+
+    def get_node(self, index):
+        node = self.nodes[index]
+        if node is None:
+            node = self.nodes[index] = NativeNode(self, index)
+        return node
+
+    def get_children(self, index):
+        start, end = self.child_start[index], self.child_start[index + 1]
+        return tuple(self.get_node(child) for child in self.children[start:end])
+
+    def get_parent(self, index):
+        parent = self.parents[index]
+        return None if parent == NONE else self.get_node(parent)
+
+    def get_event(self, index):
+        kind = self.kinds[index]
+        if kind == NODE_CALL:
+            return CallEvent(self._get_text(self.codes[index]),
+                             self._get_symbol(self.texts[index]))
+        elif kind == NODE_ASSUME:
+            if self.flags[index] & NODE_CONSTRAINT:
+                return AssumeEvent(self._get_constraint(index))
+            return AssumeEvent(self._get_symbol(self.texts[index]))
+        elif kind == NODE_EOP:
+            return EOPEvent()
+        elif kind == NODE_TRUNCATED:
+            return TruncatedEvent(self._get_text(self.texts[index]))
+        return None
+
+    def _get_budget(self, report):
+        if not self.has_budget[report]:
+            return None
+        nodes, time, limits, frontier = self.budgets[4 * report:4 * report + 4]
+        return explorer.Budget(nodes, time,
+                               [name for bit, name in enumerate(explorer.LIMITS)
+                                if limits & (1 << bit)],
+                               frontier)
+
+    def _get_constraint(self, index):
+        # the symbol and the ranges of sym@={ [from, to], ... }
+        sym = self._get_symbol(self.texts[index])
+        if not isinstance(sym, Symbol):
+            sym = parse_symbol(sym)
+        if sym is None:
+            return None
+        ranges = []
+        for i in range(self.range_start[index], self.range_start[index + 1]):
+            lo, hi = self.ranges[2 * i], self.ranges[2 * i + 1]
+            signs = self.range_signs[i]
+            ranges.append((-lo if signs & RANGE_NEGATIVE_FROM else lo,
+                           -hi if signs & RANGE_NEGATIVE_TO else hi))
+        return ConstraintSymbol(sym, ranges)
+
+    def _get_string(self, cache, sid, decode):
+        # decode(element) of the element a string was the content of,
+        # computed once per string
+        value = cache.get(sid, cache)
+        if value is cache:
+            raw = ctypes.string_at(self.base + self.string_offsets[sid],
+                                   self.string_sizes[sid]).decode("utf-8")
+            if "<" in raw or "&" in raw:
+                elem = ET.fromstring("<F>%s</F>" % raw)
+            else:
+                elem = ET.Element("F")
+                elem.text = raw
+            value = cache[sid] = decode(elem)
+        return value
+
+    def _get_text(self, sid):
+        if sid == NONE:
+            return None
+        return self._get_string(self.text_cache, sid, _get_text)
+
+    def _get_symbol(self, sid):
+        # a Symbol, or text to be parsed, as for xml
+        if sid == NONE:
+            return None
+        return self._get_string(self.symbol_cache, sid, _get_symbol)
+
+class NativeNode(object):
+    # the attributes of an ExecNode, and those checkers set on it
+    __slots__ = ("db", "index", "visited", "cmgr", "_children", "_event")
+
+    def __init__(self, db, index):
+        self.db = db
+        self.index = index
+        self.visited = False
+        self._children = None
+        self._event = None
+
+    @property
+    def children(self):
+        if self._children is None:
+            self._children = self.db.get_children(self.index)
+        return self._children
+
+    @property
+    def parent(self):
+        return self.db.get_parent(self.index)
+
+    @property
+    def event(self):
+        if self._event is None:
+            self._event = self.db.get_event(self.index)
+        return self._event
+
+    # debugging function
+    def __str__(self, i=0):
+        result = (" " * i + repr(self) + "\n")
+        for child in self.children:
+            result += child.__str__(i + 1)
+        return result
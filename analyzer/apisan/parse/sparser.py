@@ -1,5 +1,6 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
+import functools
 import os
 import sys
 from ply import yacc
@@ -159,6 +160,22 @@ class SParser(object):
         #dbg.debug('Text : %s' % self.last_text)
         return
 
+# one parser per process, since building it runs yacc
+_parser = None
+
+@functools.lru_cache(maxsize=1 << 16)
+def parse_symbol(text):
+    # the same calls and conditions are on many paths, so the symbol of a
+    # text is kept; None if the text cannot be parsed
+    global _parser
+    if _parser is None:
+        _parser = SParser()
+    try:
+        return _parser.parse(text)
+    except Exception as e:
+        #dbg.debug('Exception when parsing : %s' % e)
+        return None
+
 if __name__ == '__main__':
     parser = SParser()
     tests = ["\"String Literal\\n\"",
@@ -1,5 +1,6 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
+import weakref
 from enum import Enum
 
 class SymbolKind(Enum):
@@ -13,16 +14,41 @@ class SymbolKind(Enum):
     ID = 8
     Unknown = 9
 
-class Symbol:
-    # base class
+# live symbols by their class and constructor arguments
+_symbols = weakref.WeakValueDictionary()
+
+def _freeze(arg):
+    # a hashable form of a constructor argument; symbols are already unique
+    if isinstance(arg, (list, tuple)):
+        return tuple(_freeze(a) for a in arg)
+    return arg
+
+class _Interned(type):
+    # symbols are hash-consed: constructing a symbol equal to a live one
+    # returns that one, so that symbols compare and hash by identity
+    def __call__(cls, *args):
+        key = (cls,) + _freeze(args)
+        sym = _symbols.get(key)
+        if sym is None:
+            sym = super().__call__(*args)
+            sym._args = args
+            _symbols[key] = sym
+        return sym
+
+class Symbol(metaclass=_Interned):
+    # base class; symbols are immutable
     def __init__(self, kind):
         self.kind = kind
 
-    def __hash__(self):
-        return hash(repr(self))
+    def __reduce__(self):
+        # unpickled symbols (e.g., from pool workers) are interned again
+        return (self.__class__, self._args)
 
-    def __eq__(self, other):
-        return hash(self) == hash(other)
+    def __copy__(self):
+        return self
+
+    def __deepcopy__(self, memo):
+        return self
 
     @property
     def children(self):
@@ -126,5 +152,34 @@ class IDSymbol(Symbol):
 
 
 class UnknownSymbol(Symbol):
-    def __init__(self):
+    def __init__(self, text=None):
         super().__init__(SymbolKind.Unknown)
+        # as printed by the analyzer
+        self.text = text
+
+    def __repr__(self):
+        return "?(%s)" % self.text
+
+def from_xml(node):
+    # build a symbol from a structured <SYM> element (see SymExecSymbol.h)
+    kind = node.get("K")
+    children = [from_xml(child) for child in node if child.tag == "SYM"]
+    if kind == "call":
+        return CallSymbol(IDSymbol(node.get("N")), children)
+    elif kind == "int":
+        return ConcreteIntSymbol(int(node.get("V")))
+    elif kind == "str":
+        return StringLiteralSymbol(node.get("V"))
+    elif kind == "id":
+        return IDSymbol(node.get("N"))
+    elif kind == "field":
+        return FieldSymbol(children[0], node.get("N"))
+    elif kind == "array":
+        return ArraySymbol(children[0], children[1])
+    elif kind == "binop":
+        return BinaryOperatorSymbol(children[0], node.get("OP"), children[1])
+    elif kind == "constraint":
+        ranges = [(int(child.get("FROM")), int(child.get("TO")))
+                  for child in node if child.tag == "RANGE"]
+        return ConstraintSymbol(children[0], ranges)
+    return UnknownSymbol(node.get("V"))
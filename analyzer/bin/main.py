@@ -8,7 +8,10 @@ from apisan.parse.explorer import Explorer
 TOP = os.path.join(os.path.dirname(os.path.realpath(__file__)), "../../")
 SCAN_BUILD = os.path.join(TOP, "./llvm/tools/clang/tools/scan-build/scan-build")
 CLANG_BIN = os.path.join(TOP, "./bin/llvm/bin/clang")
+EXTRACT_BIN = os.path.join(TOP, "./bin/llvm/bin/apisan-extract")
 SYM_EXEC_EXTRACTOR = "alpha.unix.SymExecExtract"
+CACHE_DIR = os.environ.get("APISAN_CACHE_DIR",
+                           os.path.expanduser("~/.cache/apisan"))
 
 DISABLED_CHECKERS = [
     "core.CallAndMessage",
@@ -55,11 +58,23 @@ def print_bugs(bugs):
         for bug in bugs:
             print(bug)
 
-def get_command():
+def get_configs(args):
+    configs = list(CONFIGS)
+    if args.stream:
+        configs.append("apisan-stream-paths=true")
+    if args.filter:
+        configs.append("apisan-api-filter=%s" % os.path.abspath(args.filter))
+    return configs
+
+def get_command(args):
     cmds = [SCAN_BUILD]
+    if not args.no_cache:
+        cmds += ["-cache-dir", args.cache_dir]
+    if args.dedup:
+        cmds += ["-dedup"]
     for checker in DISABLED_CHECKERS:
         cmds += ["-disable-checker", checker]
-    for config in CONFIGS:
+    for config in get_configs(args):
         cmds += ["-analyzer-config", config]
     cmds += [
         "--use-analyzer", CLANG_BIN,
@@ -69,8 +84,66 @@ def get_command():
 
 def add_build_command(subparsers):
     parser = subparsers.add_parser("build", help="make a symbolic context database")
+    parser.add_argument("--cache-dir", default=CACHE_DIR,
+                        help="extraction cache (default: %(default)s)")
+    parser.add_argument("--no-cache", action="store_true",
+                        help="analyze every file again")
+    parser.add_argument("--dedup", action="store_true",
+                        help="analyze functions of headers in one file only")
+    parser.add_argument("--stream", action="store_true",
+                        help="write paths as they end (less memory)")
+    parser.add_argument("--filter", default=None,
+                        help="API filter file (see analyzer/filters)")
     parser.add_argument("cmds", nargs="+")
 
+def get_extract_command(args):
+    cmds = [EXTRACT_BIN, "-p", args.p, "-o", args.db]
+    if args.jobs:
+        cmds += ["-j", str(args.jobs)]
+    if args.dedup:
+        cmds += ["-dedup"]
+    if args.mem_budget:
+        cmds += ["-mem-budget", str(args.mem_budget)]
+    if args.resume:
+        cmds += ["-resume"]
+    if args.max_mem:
+        cmds += ["-max-mem", str(args.max_mem)]
+    if args.max_cpu:
+        cmds += ["-max-cpu", str(args.max_cpu)]
+    cmds += ["-retries", str(args.retries)]
+    for checker in DISABLED_CHECKERS:
+        cmds += ["-disable-checker", checker]
+    for config in get_configs(args):
+        cmds += ["-analyzer-config", config]
+    return cmds + args.files
+
+def add_extract_command(subparsers):
+    parser = subparsers.add_parser(
+        "extract", help="make a symbolic context database from compile_commands.json")
+    parser.add_argument("-p", required=True,
+                        help="build directory with compile_commands.json")
+    parser.add_argument("-j", "--jobs", type=int, default=0,
+                        help="parallel jobs (default: number of cores)")
+    parser.add_argument("--dedup", action="store_true",
+                        help="analyze functions of headers in one file only")
+    parser.add_argument("--stream", action="store_true",
+                        help="write paths as they end (less memory)")
+    parser.add_argument("--filter", default=None,
+                        help="API filter file (see analyzer/filters)")
+    parser.add_argument("--mem-budget", type=int, default=0,
+                        help="memory (MB) for parallel jobs (default: no limit)")
+    parser.add_argument("--resume", action="store_true",
+                        help="skip files extracted by an interrupted run")
+    parser.add_argument("--max-mem", type=int, default=0,
+                        help="memory (MB) of one job (default: no limit)")
+    parser.add_argument("--max-cpu", type=int, default=0,
+                        help="CPU time (s) of one job (default: no limit)")
+    parser.add_argument("--retries", type=int, default=1,
+                        help="retries of a job out of memory or CPU time (default: 1)")
+    parser.add_argument("--db", default=None)
+    parser.add_argument("files", nargs="*",
+                        help="files to extract (default: all)")
+
 def add_check_command(subparsers):
     parser = subparsers.add_parser("check", help="check a API misuse")
     parser.add_argument("--checker", choices=CHECKERS.keys(), required=True)
@@ -81,14 +154,21 @@ def parse_args():
     subparsers = parser.add_subparsers(dest="cmd")
     subparsers.required = True
     add_build_command(subparsers)
+    add_extract_command(subparsers)
     add_check_command(subparsers)
     return parser.parse_args()
 
 def handle_build(args):
-    cmds = get_command()
+    cmds = get_command(args)
     cmds += args.cmds
     os.spawnv(os.P_WAIT, cmds[0], cmds)
 
+def handle_extract(args):
+    if args.db is None:
+        args.db = os.path.join(os.getcwd(), "as-out")
+    cmds = get_extract_command(args)
+    os.spawnv(os.P_WAIT, cmds[0], cmds)
+
 def handle_check(args):
     if args.db is None:
         args.db = os.path.join(os.getcwd(), "as-out")
@@ -0,0 +1,770 @@
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:72</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:73</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:75</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:61</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:62</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:63</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:50</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:51</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:52</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:39</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:40</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:41</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:28</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:29</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:17</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:18</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:20</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:6</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:9</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:6</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:9</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:17</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:18</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:20</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:28</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:29</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:39</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:40</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:41</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:50</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:51</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:52</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:61</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:62</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:63</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:72</CODE><CALL><SYM K="call" N="SSL_new"><SYM K="int" V="0"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:73</CODE><CALL><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:75</CODE><CALL><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM></CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="0" TO="0"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_verify_result"><SYM K="id" N="ssl"/></SYM><RANGE FROM="-9223372036854775808" TO="-1"/><RANGE FROM="1" TO="9223372036854775807"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="call" N="SSL_get_peer_certificate"><SYM K="id" N="ssl"/></SYM><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
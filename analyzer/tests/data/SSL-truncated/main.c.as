@@ -0,0 +1,775 @@
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE NODES="1532" TIME="12" LIMITS="nodes" FRONTIER="1">
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:72</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:73</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_TRUNCATED</KIND><REASON>nodes</REASON>
+</EVENT>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:75</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:61</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:62</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:63</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:50</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:51</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:52</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:39</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:40</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:41</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:28</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:29</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:17</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:18</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:20</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:6</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:9</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:6</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:9</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:17</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:18</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:20</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:28</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:29</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:39</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:40</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:41</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:50</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:51</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:52</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:61</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:62</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:63</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
+@SYM_EXEC_EXTRACTOR_BEGIN
+<TREE>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:72</CODE><CALL>SSL_new(0)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:73</CODE><CALL>SSL_get_peer_certificate(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_CALL</KIND><CODE>main.c:75</CODE><CALL>SSL_get_verify_result(ssl)</CALL>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [0, 0] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_verify_result(ssl)@={ [-9223372036854775808, -1], [1, 9223372036854775807] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+<NODE>
+<EVENT>
+<KIND>@LOG_ASSUME</KIND><COND>SSL_get_peer_certificate(ssl)@={ [1, 18446744073709551615] }</COND>
+</EVENT>
+<NODE>
+<EVENT>
+<KIND>@LOG_EOP</KIND>
+</EVENT>
+</NODE>
+</NODE>
+</NODE>
+</NODE>
+</TREE>
+
+@SYM_EXEC_EXTRACTOR_END
@@ -1,180 +1,126 @@
+
 @SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
+<TREE NODES="27">
+<NODE ID="0">
 <EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:37</CODE><CALL>memcpy(buf2, src, sizeof (buf1))</CALL>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="id" N="src"/><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
 </EVENT>
-<NODE>
+<NODE ID="1">
 <EVENT>
-<KIND>@LOG_EOP</KIND>
+<KIND>@LOG_CALL</KIND><CODE>main.c:37</CODE><CALL><SYM K="call" N="memcpy"><SYM K="id" N="buf2"/><SYM K="id" N="src"/><SYM K="call" N="sizeof"><SYM K="id" N="buf1"/></SYM></SYM></CALL>
 </EVENT>
-</NODE>
-</NODE>
-</TREE>
-
-@SYM_EXEC_EXTRACTOR_END
-@SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
-<EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
-</EVENT>
-<NODE>
+<NODE ID="2">
 <EVENT>
 <KIND>@LOG_EOP</KIND>
 </EVENT>
 </NODE>
 </NODE>
+</NODE>
 </TREE>
 
 @SYM_EXEC_EXTRACTOR_END
+
 @SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
+<TREE NODES="27">
+<NODE ID="0">
 <EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:25</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="id" N="src"/><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
 </EVENT>
-<NODE>
+<NODE ID="1">
 <EVENT>
-<KIND>@LOG_EOP</KIND>
+<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL><SYM K="call" N="memcpy"><SYM K="id" N="buf2"/><SYM K="id" N="src"/><SYM K="call" N="sizeof"><SYM K="id" N="buf2"/></SYM></SYM></CALL>
 </EVENT>
-</NODE>
-</NODE>
-</TREE>
-
-@SYM_EXEC_EXTRACTOR_END
-@SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
-<EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:19</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
-</EVENT>
-<NODE>
+<NODE ID="2">
 <EVENT>
 <KIND>@LOG_EOP</KIND>
 </EVENT>
 </NODE>
 </NODE>
+</NODE>
 </TREE>
 
 @SYM_EXEC_EXTRACTOR_END
+
 @SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
-<EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:13</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
-</EVENT>
-<NODE>
+<TREE NODES="27">
+<NODE ID="0">
 <EVENT>
-<KIND>@LOG_EOP</KIND>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="id" N="src"/><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
 </EVENT>
-</NODE>
-</NODE>
-</TREE>
-
-@SYM_EXEC_EXTRACTOR_END
-@SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
+<NODE ID="1">
 <EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
+<KIND>@LOG_CALL</KIND><CODE>main.c:25</CODE><CALL><SYM K="call" N="memcpy"><SYM K="id" N="buf2"/><SYM K="id" N="src"/><SYM K="call" N="sizeof"><SYM K="id" N="buf2"/></SYM></SYM></CALL>
 </EVENT>
-<NODE>
+<NODE ID="2">
 <EVENT>
 <KIND>@LOG_EOP</KIND>
 </EVENT>
 </NODE>
 </NODE>
+</NODE>
 </TREE>
 
 @SYM_EXEC_EXTRACTOR_END
+
 @SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
+<TREE NODES="27">
+<NODE ID="0">
 <EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="id" N="src"/><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
 </EVENT>
-<NODE>
+<NODE ID="1">
 <EVENT>
-<KIND>@LOG_EOP</KIND>
+<KIND>@LOG_CALL</KIND><CODE>main.c:19</CODE><CALL><SYM K="call" N="memcpy"><SYM K="id" N="buf2"/><SYM K="id" N="src"/><SYM K="call" N="sizeof"><SYM K="id" N="buf2"/></SYM></SYM></CALL>
 </EVENT>
-</NODE>
-</NODE>
-</TREE>
-
-@SYM_EXEC_EXTRACTOR_END
-@SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
-<EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:13</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
-</EVENT>
-<NODE>
+<NODE ID="2">
 <EVENT>
 <KIND>@LOG_EOP</KIND>
 </EVENT>
 </NODE>
 </NODE>
+</NODE>
 </TREE>
 
 @SYM_EXEC_EXTRACTOR_END
+
 @SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
+<TREE NODES="27">
+<NODE ID="0">
 <EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:19</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="id" N="src"/><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
 </EVENT>
-<NODE>
+<NODE ID="1">
 <EVENT>
-<KIND>@LOG_EOP</KIND>
+<KIND>@LOG_CALL</KIND><CODE>main.c:13</CODE><CALL><SYM K="call" N="memcpy"><SYM K="id" N="buf2"/><SYM K="id" N="src"/><SYM K="call" N="sizeof"><SYM K="id" N="buf2"/></SYM></SYM></CALL>
 </EVENT>
-</NODE>
-</NODE>
-</TREE>
-
-@SYM_EXEC_EXTRACTOR_END
-@SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
-<EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:25</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
-</EVENT>
-<NODE>
+<NODE ID="2">
 <EVENT>
 <KIND>@LOG_EOP</KIND>
 </EVENT>
 </NODE>
 </NODE>
+</NODE>
 </TREE>
 
 @SYM_EXEC_EXTRACTOR_END
+
 @SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
-<EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:31</CODE><CALL>memcpy(buf2, src, sizeof (buf2))</CALL>
-</EVENT>
-<NODE>
+<TREE NODES="27">
+<NODE ID="0">
 <EVENT>
-<KIND>@LOG_EOP</KIND>
+<KIND>@LOG_ASSUME</KIND><COND><SYM K="constraint"><SYM K="id" N="src"/><RANGE FROM="1" TO="18446744073709551615"/></SYM></COND>
 </EVENT>
-</NODE>
-</NODE>
-</TREE>
-
-@SYM_EXEC_EXTRACTOR_END
-@SYM_EXEC_EXTRACTOR_BEGIN
-<TREE>
-<NODE>
+<NODE ID="1">
 <EVENT>
-<KIND>@LOG_CALL</KIND><CODE>main.c:37</CODE><CALL>memcpy(buf2, src, sizeof (buf1))</CALL>
+<KIND>@LOG_CALL</KIND><CODE>main.c:7</CODE><CALL><SYM K="call" N="memcpy"><SYM K="id" N="buf2"/><SYM K="id" N="src"/><SYM K="call" N="sizeof"><SYM K="id" N="buf2"/></SYM></SYM></CALL>
 </EVENT>
-<NODE>
+<NODE ID="2">
 <EVENT>
 <KIND>@LOG_EOP</KIND>
 </EVENT>
 </NODE>
 </NODE>
+</NODE>
 </TREE>
 
 @SYM_EXEC_EXTRACTOR_END
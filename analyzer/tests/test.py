@@ -1,9 +1,18 @@
 # SPDX-License-Identifier: MIT
 #!/usr/bin/env python3
+import copy
+import os
+import pickle
+import tempfile
 import unittest
 import config
-from apisan.lib import dbg
-from apisan.parse.explorer import Explorer
+from apisan.lib import dbg, utils
+from apisan.parse import asb, native
+from apisan.parse.event import AssumeEvent, CallEvent, EOPEvent, TruncatedEvent
+from apisan.parse.explorer import ConstraintMgr, Explorer, ExecNode, ExecTree
+from apisan.parse.explorer import iter_reports
+from apisan.parse.explorer import is_call, is_truncated, sig_begin, sig_end
+from apisan.parse.sparser import parse_symbol
 from apisan.check.argument import ArgChecker
 from apisan.check.causality import CausalityChecker
 from apisan.check.condition import CondChecker
@@ -12,6 +21,24 @@ from apisan.check.fsb import FSBChecker
 from apisan.check.intovfl import IntOvflChecker
 from apisan.check.retval import RetValChecker
 
+def get_events(tree):
+    # the events of a tree in depth-first order, shared nodes once
+    events = []
+    seen = set()
+    nodes = [tree.root]
+    while nodes:
+        node = nodes.pop()
+        if id(node) in seen:
+            events.append(("REF", len(node.children)))
+            continue
+        seen.add(id(node))
+        event = node.event
+        events.append((type(event), len(node.children),
+                       getattr(event, "code", None), getattr(event, "call", None),
+                       getattr(event, "cond", None), getattr(event, "reason", None)))
+        nodes.extend(reversed(node.children))
+    return events
+
 class TestApiSan(unittest.TestCase):
     def test_retval(self):
         chk = RetValChecker()
@@ -37,6 +64,187 @@ class TestApiSan(unittest.TestCase):
         bugs = exp.explore_parallel(config.get_data_dir("SSL"))
         assert(len(bugs) == 2) # (X, Y), (Y, X)
 
+    def test_SSL_graph(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        bugs = exp.explore_parallel(config.get_data_dir("SSL-graph"))
+        assert(len(bugs) == 2) # same as SSL, with shared nodes
+
+    def test_SSL_asb(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        bugs = exp.explore_parallel(config.get_data_dir("SSL-asb"))
+        assert(len(bugs) == 2) # same as SSL, in binary format
+
+    def test_SSL_tree(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        bugs = exp.explore_parallel(config.get_data_dir("SSL-tree"))
+        assert(len(bugs) == 2) # same as SSL, with structured symbols
+
+    def test_SSL_manifest(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        data_dir = config.get_data_dir("SSL-manifest")
+        # old.c, analyzed again with other options and no paths, replaces
+        # its earlier record, whose database is left but not read
+        assert(len(utils.get_all_files(data_dir)) == 1)
+        bugs = exp.explore_parallel(data_dir)
+        assert(len(bugs) == 2) # same as SSL, listed in a manifest
+
+    def test_SSL_truncated(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        data_dir = config.get_data_dir("SSL-truncated")
+        bugs = exp.explore_parallel(data_dir)
+        assert(len(bugs) == 2) # same as SSL, the cut path is not counted
+
+        # budgets and TRUNCATED events survive the binary format
+        with tempfile.TemporaryDirectory() as tmp:
+            fn = os.path.join(tmp, "main.c.asb")
+            asb.convert(os.path.join(data_dir, "main.c.as"), fn)
+            forest = asb.AsbReader(fn).parse()
+        assert(forest[0].budget.limits == ["nodes"])
+        assert(forest[0].budget.frontier == 1)
+        call = forest[0].root.children[0]
+        assert(any(is_truncated(child) for child in call.children))
+
+    def test_truncated_paths(self):
+        # a path cut right after each call, next to the complete ones, neither
+        # hides the reports of the complete paths nor adds its own
+        def get_bugs(chk, data_dir, cut):
+            forest = []
+            for fn in utils.get_all_files(data_dir):
+                for roots, budget in iter_reports(fn, ExecNode.from_xml):
+                    forest += [ExecTree(root, budget) for root in roots]
+            for tree in forest:
+                nodes = [tree.root]
+                while cut and nodes:
+                    node = nodes.pop()
+                    nodes.extend(node.children)
+                    if is_call(node):
+                        node.children.append(
+                            ExecNode(TruncatedEvent("nodes"), []))
+            bugs = chk.merge([chk.process(tree) for tree in forest])
+            return sorted((bug.code, repr(bug.key), repr(bug.ctx))
+                          for bug in bugs)
+
+        for chk, name in [(CausalityChecker(), "memory-leak"),
+                          (CausalityChecker(), "missing-unlock"),
+                          (CondChecker(), "SSL"),
+                          (RetValChecker(), "return-value")]:
+            data_dir = config.get_data_dir(name)
+            bugs = get_bugs(chk, data_dir, False)
+            assert(len(bugs) >= 1)
+            assert(get_bugs(chk, data_dir, True) == bugs)
+
+    def test_SSL_stream(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        data_dir = config.get_data_dir("SSL-stream")
+        bugs = exp.explore_parallel(data_dir)
+        assert(len(bugs) == 2) # same as SSL-truncated
+
+        # the budget closes a streamed report
+        with tempfile.TemporaryDirectory() as tmp:
+            fn = os.path.join(tmp, "main.c.asb")
+            asb.convert(os.path.join(data_dir, "main.c.as"), fn)
+            forest = asb.AsbReader(fn).parse()
+        assert(forest[0].budget.limits == ["nodes"])
+        assert(forest[0].budget.frontier == 1)
+
+    def test_SSL_damaged(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        fn = os.path.join(config.get_data_dir("SSL"),
+                          "api-sanitizer/test/SSL/main.c.as")
+        with tempfile.TemporaryDirectory() as tmp:
+            # a report cut by a crash is skipped, not the whole file
+            with open(fn) as f, open(os.path.join(tmp, "main.c.as"), "w") as out:
+                out.write("%s\n<TREE><ROOT>\n%s\n" % (sig_begin(), sig_end()))
+                out.write(f.read())
+            bugs = exp.explore_parallel(tmp)
+        assert(len(bugs) == 2)
+
+    def test_SSL_blocks(self):
+        chk = CondChecker()
+        exp = Explorer(chk)
+        fn = os.path.join(config.get_data_dir("SSL"),
+                          "api-sanitizer/test/SSL/main.c.as")
+        with tempfile.TemporaryDirectory() as tmp:
+            # a report longer than a block of the reader is read in pieces
+            with open(fn) as f, open(os.path.join(tmp, "main.c.as"), "w") as out:
+                for line in f:
+                    out.write(line + "\n")
+            bugs = exp.explore_parallel(tmp)
+        assert(len(bugs) == 2)
+
+    @unittest.skipUnless(native.is_available(), "libApisanDB is not built")
+    def test_native(self):
+        # the native reader builds the trees of the Python reader
+        for top, dirs, files in os.walk(os.path.join(config.TOP, "data")):
+            for fn in files:
+                if not fn.endswith(".as"):
+                    continue
+                fn = os.path.join(top, fn)
+                forest = [ExecTree(root, budget)
+                          for roots, budget in iter_reports(fn, ExecNode.from_xml)
+                          for root in roots]
+                native_forest = native.NativeDatabase(fn).parse()
+                assert(len(forest) == len(native_forest))
+                for tree, native_tree in zip(forest, native_forest):
+                    assert(tree.budget == native_tree.budget)
+                    assert(get_events(tree) == get_events(native_tree))
+
+    def test_shared_prefixes(self):
+        # if (f_i() == 0) g_i(); else h_i(); for 30 levels sharing their
+        # tails: 2**30 paths, a walk of the tree's size
+        node = ExecNode(EOPEvent(), [])
+        for i in reversed(range(30)):
+            node = ExecNode(CallEvent("m.c:%d" % i, "f%d()" % i), [
+                ExecNode(AssumeEvent("f%d()@={ [0, 0] }" % i),
+                         [ExecNode(CallEvent("m.c:g%d" % i, "g%d()" % i),
+                                   [node])]),
+                ExecNode(AssumeEvent("f%d()@={ [1, 1] }" % i),
+                         [ExecNode(CallEvent("m.c:h%d" % i, "h%d()" % i),
+                                   [node])])])
+        chk = CausalityChecker()
+        ctx = chk.process(ExecTree(node))
+        names = {}
+        while node.children:
+            names[node.event.call.name.id] = node.event.call.name
+            node = node.children[0].children[0]
+            names[node.event.call.name.id] = node.event.call.name
+            node = node.children[0]
+        follows = ctx.entries[((names["f0"], ((0, 0),)), "m.c:0")]
+        assert(follows == {names["g0"]} | {names["f%d" % i] for i in range(1, 30)})
+        assert(ctx.entries[((names["g29"], None), "m.c:g29")] == set())
+
+    def test_constraint_mgr(self):
+        # a path of 20 constraints, past a few foldings, and a branch of it
+        cmgrs = [ConstraintMgr()]
+        for i in range(20):
+            node = ExecNode(AssumeEvent("x%d@={ [%d, %d] }" % (i, i, i)), [])
+            cmgrs.append(cmgrs[-1].feed(node))
+        cmgr = cmgrs[-1]
+        assert(len(cmgr) == 20)
+        for i in range(20):
+            sym = parse_symbol("x%d" % i)
+            assert(cmgr.get(sym) == [(i, i)])
+            assert(cmgr.get(sym, True) == ((i, i),))
+            assert(cmgrs[i].get(sym) is None)
+        # the first constraint of a symbol is kept
+        assert(cmgr.feed(ExecNode(AssumeEvent("x3@={ [0, 9] }"), [])) is None)
+        branch = cmgrs[10].feed(ExecNode(AssumeEvent("x15@={ [0, 9] }"), []))
+        assert(branch.get(parse_symbol("x15")) == [(0, 9)])
+        assert(cmgr.get(parse_symbol("x15")) == [(15, 15)])
+        assert(dict(branch.items()) ==
+               dict(list(cmgrs[10].items()) + [(parse_symbol("x15"), [(0, 9)])]))
+        # the size is the number of distinct symbols, which _get_prefix
+        # compares with the symbols a subtree uses
+        for c in cmgrs + [branch]:
+            assert(len(c) == len(list(c.items())) == len(dict(c.items())))
+
     def test_intovfl(self):
         chk = IntOvflChecker()
         exp = Explorer(chk)
@@ -55,5 +263,28 @@ class TestApiSan(unittest.TestCase):
         bugs = exp.explore_parallel(config.get_data_dir("argument"))
         assert(len(bugs) == 1)
 
+    def test_arg_sizeof(self):
+        # sizeof(buf) is extracted as itself, not as the size it evaluates to
+        fn = os.path.join(config.get_data_dir("argument"),
+                          "api-sanitizer", "test", "argument", "main.c.as")
+        sizes = []
+        for roots, budget in iter_reports(fn, ExecNode.from_xml):
+            for root in roots:
+                tree = ExecTree(root, budget)
+                for event in get_events(tree):
+                    if event[0] is CallEvent and str(event[3].name) == "memcpy":
+                        sizes.append(repr(event[3].args[2]))
+        assert(sorted(sizes) == ["sizeof([buf1])"] + ["sizeof([buf2])"] * 5)
+
+    def test_symbol_interning(self):
+        text = "malloc(256)@={ [0, 0], [2, 18446744073709551615] }"
+        sym = parse_symbol(text)
+        assert(sym is parse_symbol(text))
+        # equal symbols are one object, even if parsed from other texts
+        assert(sym.symbol is parse_symbol("malloc(256)"))
+        assert(copy.deepcopy(sym) is sym)
+        assert(pickle.loads(pickle.dumps(sym)) is sym)
+        assert(parse_symbol("malloc(") is None)
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,126 @@
+//=== SymExecDatabase.cpp - Binary symbolic-context database ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines AsbWriter, which writes the binary .asb format.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymExecDatabase.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+using namespace ento;
+
+static const char AsbMagic[] = "ASB";
+
+AsbWriter::AsbWriter(raw_ostream &OS) : OS(OS), Pos(0) {
+  OS << AsbMagic << (char)Version;
+  Pos += 4;
+}
+
+unsigned AsbWriter::intern(StringRef S) {
+  std::pair<llvm::StringMap<unsigned>::iterator, bool> R =
+    StringIDs.insert(std::make_pair(S, (unsigned)Strings.size()));
+  if (R.second)
+    Strings.push_back(R.first->getKey());
+  return R.first->getValue();
+}
+
+void AsbWriter::writeULEB128(uint64_t Value) {
+  llvm::encodeULEB128(Value, OS);
+  Pos += llvm::getULEB128Size(Value);
+}
+
+uint64_t AsbWriter::beginRecord(RecordKind K) {
+  uint64_t Offset = Pos;
+  writeULEB128(K);
+  return Offset;
+}
+
+unsigned AsbWriter::endRecord(uint64_t Offset, ArrayRef<unsigned> Children) {
+  writeULEB128(Children.size());
+  for (unsigned Child : Children) {
+    assert(Child < Offsets.size() && "child must be written first");
+    writeULEB128(Offset - Offsets[Child]);
+  }
+  Offsets.push_back(Offset);
+  return Offsets.size() - 1;
+}
+
+unsigned AsbWriter::addCall(StringRef File, unsigned Line, StringRef Call,
+                            ArrayRef<unsigned> Children) {
+  unsigned FileID = intern(File);
+  unsigned CallID = intern(Call);
+  uint64_t Offset = beginRecord(RK_Call);
+  writeULEB128(FileID);
+  writeULEB128(Line);
+  writeULEB128(CallID);
+  return endRecord(Offset, Children);
+}
+
+unsigned AsbWriter::addAssume(StringRef Cond, ArrayRef<unsigned> Children) {
+  unsigned CondID = intern(Cond);
+  uint64_t Offset = beginRecord(RK_Assume);
+  writeULEB128(CondID);
+  return endRecord(Offset, Children);
+}
+
+unsigned AsbWriter::addEOP(ArrayRef<unsigned> Children) {
+  uint64_t Offset = beginRecord(RK_EOP);
+  return endRecord(Offset, Children);
+}
+
+unsigned AsbWriter::addTruncated(StringRef Reason,
+                                 ArrayRef<unsigned> Children) {
+  unsigned ReasonID = intern(Reason);
+  uint64_t Offset = beginRecord(RK_Truncated);
+  writeULEB128(ReasonID);
+  return endRecord(Offset, Children);
+}
+
+void AsbWriter::addFunction(StringRef Name, ArrayRef<unsigned> Roots,
+                            const SymExecBudget &Budget) {
+  FunctionEntry F;
+  F.Name = intern(Name);
+  F.Budget = Budget;
+  for (unsigned Root : Roots)
+    F.Roots.push_back(Offsets[Root]);
+  Functions.push_back(F);
+  Offsets.clear();
+}
+
+void AsbWriter::finish() {
+  uint64_t Footer = Pos;
+
+  writeULEB128(Strings.size());
+  for (StringRef S : Strings) {
+    writeULEB128(S.size());
+    OS << S;
+    Pos += S.size();
+  }
+
+  writeULEB128(Functions.size());
+  for (const FunctionEntry &F : Functions) {
+    writeULEB128(F.Name);
+    writeULEB128(F.Roots.size());
+    for (uint64_t Root : F.Roots)
+      writeULEB128(Root);
+    writeULEB128(F.Budget.Nodes);
+    writeULEB128(F.Budget.TimeMs);
+    writeULEB128(F.Budget.Limits);
+    writeULEB128(F.Budget.Frontier);
+  }
+
+  for (unsigned i = 0; i != 8; ++i)
+    OS << (char)((Footer >> (i * 8)) & 0xff);
+  OS << AsbMagic << (char)Version;
+  Pos += 12;
+  OS.flush();
+}
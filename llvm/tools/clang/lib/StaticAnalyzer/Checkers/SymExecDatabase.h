@@ -0,0 +1,127 @@
+//=== SymExecDatabase.h - Binary symbolic-context database ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Declares AsbWriter, which writes the paths extracted by SymExecExtractor in
+// the binary .asb format (read by analyzer/apisan/parse/asb.py).
+//
+// All integers are unsigned LEB128 unless noted otherwise.
+//
+//   header  : "ASB" <version:u8>
+//   records : node records of every function, children before parents
+//     CALL   : 0 <file> <line> <call> <#children> <child delta>...
+//     ASSUME : 1 <cond> <#children> <child delta>...
+//     EOP    : 2 <#children> <child delta>...
+//     TRUNC  : 3 <reason> <#children> <child delta>...
+//   footer  : <#strings> (<length> <bytes>)...
+//             <#functions> (<name> <#roots> <root offset>...
+//                           <#nodes> <time ms> <limits> <#frontier>)...
+//   trailer : <footer offset:u64 little endian> "ASB" <version:u8>
+//
+// Strings (file names, calls, conditions and function names) are IDs into the
+// string table of the translation unit. Calls and conditions are <SYM>
+// trees, see SymExecSymbol.h. A child delta is the distance from
+// the start of a record back to the start of its child, so a node shared by
+// several paths is written once. The budget figures of a function are those
+// of SymExecBudget.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_STATICANALYZER_CHECKERS_SYMEXECDATABASE_H
+#define LLVM_CLANG_LIB_STATICANALYZER_CHECKERS_SYMEXECDATABASE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <vector>
+
+namespace clang {
+namespace ento {
+
+/// \brief How much of its budgets the analysis of a top-level function used.
+struct SymExecBudget {
+  enum Limit {
+    L_Nodes = 1,    // max-nodes
+    L_Time = 2,     // max-time
+    L_Blocks = 4,   // max visits of a block on a path
+    L_Aborted = 8   // the engine could not handle a statement
+  };
+
+  SymExecBudget() : Nodes(0), TimeMs(0), Limits(0), Frontier(0) {}
+
+  uint64_t Nodes;
+  // Milliseconds spent, if max-time was set (0 otherwise)
+  uint64_t TimeMs;
+  // Limits hit, as a mask of Limit
+  unsigned Limits;
+  // Nodes where the analysis stopped before the end of their path
+  unsigned Frontier;
+};
+
+class AsbWriter {
+public:
+  enum { Version = 2 };
+
+  enum RecordKind {
+    RK_Call = 0,
+    RK_Assume = 1,
+    RK_EOP = 2,
+    RK_Truncated = 3
+  };
+
+  explicit AsbWriter(raw_ostream &OS);
+
+  /// \brief Writes a node record and returns its index in the current
+  /// function. \p Children are indices of records written before.
+  unsigned addCall(StringRef File, unsigned Line, StringRef Call,
+                   ArrayRef<unsigned> Children);
+  unsigned addAssume(StringRef Cond, ArrayRef<unsigned> Children);
+  unsigned addEOP(ArrayRef<unsigned> Children);
+  unsigned addTruncated(StringRef Reason, ArrayRef<unsigned> Children);
+
+  /// \brief Closes the current function. \p Roots are the indices of the
+  /// records each path starts with.
+  void addFunction(StringRef Name, ArrayRef<unsigned> Roots,
+                   const SymExecBudget &Budget);
+
+  /// \brief Writes the string table, the function index and the trailer.
+  void finish();
+
+  /// \brief Returns the number of bytes written so far.
+  uint64_t tell() const { return Pos; }
+
+private:
+  struct FunctionEntry {
+    unsigned Name;
+    SmallVector<uint64_t, 2> Roots;
+    SymExecBudget Budget;
+  };
+
+  unsigned intern(StringRef S);
+  void writeULEB128(uint64_t Value);
+  uint64_t beginRecord(RecordKind K);
+  unsigned endRecord(uint64_t Offset, ArrayRef<unsigned> Children);
+
+  raw_ostream &OS;
+  // Bytes written so far
+  uint64_t Pos;
+
+  llvm::StringMap<unsigned> StringIDs;
+  // Keys of StringIDs, by ID
+  std::vector<StringRef> Strings;
+  // Record offsets of the current function, by index
+  std::vector<uint64_t> Offsets;
+  std::vector<FunctionEntry> Functions;
+};
+
+} // end namespace ento
+} // end namespace clang
+
+#endif
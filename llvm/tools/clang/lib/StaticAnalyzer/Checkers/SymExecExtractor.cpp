@@ -0,0 +1,1407 @@
+//== SymExecExtractor.cpp --------------------------------------------*- C++ -*--==//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines SymExecExtractor, which prints out path conditions
+// for each return code.
+//===----------------------------------------------------------------------===//
+
+#include "ClangSACheckers.h"
+#include "SymExecDatabase.h"
+#include "SymExecFilter.h"
+#include "SymExecSymbol.h"
+#include "clang/StaticAnalyzer/Core/BugReporter/BugType.h"
+#include "clang/StaticAnalyzer/Core/Checker.h"
+#include "clang/StaticAnalyzer/Core/CheckerManager.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/CheckerContext.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/ProgramStateTrait.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#ifdef LLVM_ON_UNIX
+#include <sys/resource.h>
+#endif
+
+using namespace clang;
+using namespace ento;
+
+#define DEBUG_TYPE "SymExecExtractor"
+
+STATISTIC(NumNodesVisited,
+          "The # of exploded nodes visited while dumping paths");
+STATISTIC(NumEventsEmitted,
+          "The # of event nodes emitted by the extractor");
+STATISTIC(NumBytesWritten,
+          "The # of bytes written by the extractor");
+STATISTIC(NumTruncatedDumps,
+          "The # of functions whose dump hit the size limit");
+STATISTIC(NumGraphNodes,
+          "The # of exploded nodes in the graphs of the analyzed functions");
+STATISTIC(MaxGraphNodes,
+          "The maximum # of exploded nodes in the graph of a function");
+STATISTIC(NumPinnedSymbols,
+          "The # of constrained call-return symbols kept alive across purges");
+STATISTIC(NumBudgetExhausted,
+          "The # of functions whose analysis hit a budget");
+STATISTIC(NumTruncatedEvents,
+          "The # of TRUNCATED events emitted at frontier nodes");
+STATISTIC(NumCallsIgnored,
+          "The # of calls not recorded because of the API filter");
+STATISTIC(NumCallsWithoutArgs,
+          "The # of calls recorded without arguments because of the API "
+          "filter");
+
+namespace {
+// Strings referred to by events, interned for the whole translation unit so
+// that events stay small and are cheap to copy and profile.
+class SymExecStringPool {
+public:
+  SymExecStringPool() { intern(""); }
+
+  unsigned intern(StringRef S);
+  StringRef get(unsigned ID) const { return Strings[ID]; }
+
+private:
+  llvm::StringMap<unsigned> IDs;
+  // Keys of IDs, by ID
+  std::vector<StringRef> Strings;
+};
+
+class SymExecEvent {
+public:
+  enum Kind {
+    FN_CALL,
+    ASSUME,
+    EOP,
+    // The path was cut by a budget (the payload is the reason)
+    TRUNCATED
+  };
+
+  SymExecEvent(Kind k);
+  SymExecEvent(Kind k, const Stmt* s, CheckerContext &C,
+               SymExecStringPool &Strings, SymExecFilter &Filter);
+  SymExecEvent(Kind k, StringRef serialized, SymExecStringPool &Strings);
+
+  void Profile(llvm::FoldingSetNodeID &ID) const;
+  bool operator==(const SymExecEvent &RHS) const {
+    return K == RHS.K && File == RHS.File && Line == RHS.Line && SV == RHS.SV;
+  }
+  bool operator<(const SymExecEvent &RHS) const {
+    if (K != RHS.K)
+      return K < RHS.K;
+    if (File != RHS.File)
+      return File < RHS.File;
+    if (Line != RHS.Line)
+      return Line < RHS.Line;
+    return SV < RHS.SV;
+  }
+  std::string getAsString(const SymExecStringPool &Strings) const;
+  std::string getKindAsXMLNode() const;
+  std::string getCodeAsXMLNode(const SymExecStringPool &Strings) const;
+  unsigned writeTo(AsbWriter &W, const SymExecStringPool &Strings,
+                   ArrayRef<unsigned> Children) const;
+
+private:
+  Kind K;
+  // Presumed location of the call (Line is 0 if it is invalid)
+  unsigned File;
+  unsigned Line;
+  // For condition event
+  unsigned SV;
+};
+
+// Events recorded outside of ProgramState (apisan-event-trail=side-table),
+// so that states differing only in their call history are still merged by
+// the engine. The dump reads the events back from the graph.
+struct SymExecEventTable {
+  // FN_CALL and EOP events, by the tagged node recording them
+  llvm::DenseMap<const ExplodedNode*, SymExecEvent> NodeEvents;
+  // ASSUME events, by the constraints of the state evalAssume returned
+  // (ConstraintManager::getConstraintsID) and the symbol it constrained.
+  // The engine often changes the state again, e.g. binds the value of the
+  // condition, before the state reaches a node, but not its constraints.
+  // Assumptions on different symbols can end in the same constraints; a
+  // node is given the one whose symbol's ranges changed on the way to it.
+  struct AssumeEvent {
+    SymbolRef Sym;
+    SymExecEvent Event;
+  };
+  llvm::DenseMap<const void*, SmallVector<AssumeEvent, 1> > AssumeEvents;
+  // Keeps the constraints above alive, so that their IDs are not reused
+  std::vector<ProgramStateRef> AssumedStates;
+
+  void addAssumeEvent(ProgramStateRef State, SymbolRef Sym,
+                      const SymExecEvent &E);
+  const SymExecEvent *getEvent(const ExplodedNode *Cur,
+                               const ExplodedNode *Prev) const;
+  void clear();
+};
+
+// Writes the paths of a top-level function as they end
+// (apisan-stream-paths), instead of walking its graph once the analysis is
+// over. A path shares the events it starts with with the path written before
+// it, whose events are still open, so the paths of a depth-first analysis
+// are mostly written once. Only the events of the last path are kept.
+class SymExecPathWriter {
+public:
+  SymExecPathWriter(llvm::raw_ostream &OS, const SymExecStringPool &Strings,
+                    AsbWriter *Writer, uint64_t Limit)
+    : OS(OS), Strings(Strings), Writer(Writer), Limit(Limit),
+      Truncated(false) {}
+
+  void addPath(ArrayRef<SymExecEvent> Path);
+  /// \brief Closes the open events and returns the records the paths start
+  /// with (binary output only).
+  ArrayRef<unsigned> finish();
+  bool isTruncated() const { return Truncated; }
+
+private:
+  struct OpenEvent {
+    explicit OpenEvent(const SymExecEvent &Event) : Event(Event) {}
+
+    SymExecEvent Event;
+    // Records written below Event
+    SmallVector<unsigned, 2> Children;
+  };
+
+  void closeEvent();
+
+  llvm::raw_ostream &OS;
+  const SymExecStringPool &Strings;
+  AsbWriter *Writer;
+  // Stream position at which writing stops (0: no limit)
+  uint64_t Limit;
+  bool Truncated;
+  // Events of the last path
+  std::vector<OpenEvent> Open;
+  SmallVector<unsigned, 2> Roots;
+};
+
+class SymExecExtractor : public Checker< eval::Assume,
+                                         check::PostStmt<CallExpr>,
+                                         check::LiveSymbols,
+                                         check::EndFunction,
+                                         check::EndAnalysis,
+                                         check::EndOfTranslationUnit > {
+public:
+  SymExecExtractor(AnalyzerOptions &AO);
+  ProgramStateRef evalAssume(ProgramStateRef State,
+                                 SVal Cond,
+                                 bool Assumption) const;
+  void checkPostStmt(const CallExpr *CE, CheckerContext &C) const;
+  void checkLiveSymbols(ProgramStateRef State, SymbolReaper &SR) const;
+  void checkEndFunction(CheckerContext &C) const;
+  void checkEndAnalysis(ExplodedGraph &G, BugReporter &BR, ExprEngine &N) const;
+  void checkEndOfTranslationUnit(const TranslationUnitDecl *TU,
+                                 AnalysisManager &Mgr,
+                                 BugReporter &BR) const;
+
+private:
+  // Bug type
+  std::unique_ptr<BugType> SymExecExtractorReportType;
+  mutable std::string TypeInfo;
+  // Callees whose calls are not recorded, or recorded without arguments
+  // (apisan-api-filter)
+  mutable SymExecFilter Filter;
+  // Payloads of the events in EventList
+  mutable SymExecStringPool Strings;
+  // Keep events in SideEvents instead of EventList
+  bool UseSideTable;
+  mutable SymExecEventTable SideEvents;
+  // Dead symbols are purged (-analyzer-purge is not none), so the return
+  // symbols of calls that a path condition constrains are kept in
+  // PinnedSymbols. The set is kept out of ProgramState, so that it does not
+  // keep states apart, and holds the symbols of the whole analysis.
+  bool PinCallReturns;
+  mutable llvm::DenseSet<SymbolRef> PinnedSymbols;
+  // Emit shared ExplodedNodes once and back-reference them afterwards
+  bool DumpAsGraph;
+  // No path diagnostic consumer is registered (-analyzer-output=none), so
+  // reports are not turned into BugReports
+  bool ExtractOnly;
+  // Maximum bytes dumped per top-level function (0: no limit)
+  uint64_t MaxDumpBytes;
+  // Write the binary database (.asb) instead of XML reports
+  bool DumpAsBinary;
+  // Write each path of a top-level function when it ends, rather than
+  // walking the graph at the end of the analysis. The paths are read from
+  // EventList, and no BugReports are made.
+  bool StreamPaths;
+  mutable std::unique_ptr<SymExecPathWriter> PathWriter;
+  // Stream position at which the current function started
+  mutable uint64_t StreamStart;
+  // Reports not written to a file go to stderr through this buffer
+  mutable std::unique_ptr<llvm::raw_fd_ostream> ErrStream;
+  // Write the database of each translation unit to OutputFile, or to a file
+  // under OutputDir, instead of reporting it on stderr
+  std::string OutputFile;
+  std::string OutputDir;
+  // The database is written to TempPath and renamed to OutPath at the end of
+  // the translation unit, so that readers never see a partial file
+  mutable std::string OutPath;
+  mutable SmallString<128> TempPath;
+  mutable std::unique_ptr<llvm::raw_fd_ostream> OutStream;
+  mutable std::unique_ptr<AsbWriter> DB;
+  // The database is named after TUKey (apisan-tu-key, the hash of the main
+  // file by default) and recorded in the manifest of the database directory
+  mutable std::string TUKey;
+  std::string ManifestPath;
+  // Figures of the translation unit for its manifest record
+  mutable unsigned NumFunctions;
+  mutable unsigned NumTrees;
+  mutable unsigned NumFiltered;
+  mutable uint64_t OutSize;
+  double StartTime;
+private:
+  SymExecFilter::Action filterCall(const FunctionDecl *FD) const;
+  void pinCallReturn(SymbolRef Sym) const;
+  ExplodedNode *addEvent(CheckerContext &C, ProgramStateRef State,
+                         const SymExecEvent &E) const;
+  const SymExecEventTable *getSideEvents() const {
+    return UseSideTable ? &SideEvents : nullptr;
+  }
+  void dumpPaths(ExplodedGraph &G, BugReporter &BR, ExprEngine &Eng) const;
+  SymExecPathWriter &getPathWriter(const SourceManager &SM) const;
+  void streamPath(const SourceManager &SM, const ExplodedNode *N) const;
+  void finishPaths(ExplodedGraph &G, BugReporter &BR, ExprEngine &Eng) const;
+  llvm::raw_fd_ostream &getReportStream(const SourceManager &SM) const;
+  bool writesToFile() const {
+    return !OutputFile.empty() || !OutputDir.empty();
+  }
+  StringRef getTUKey(const SourceManager &SM) const;
+  std::string getRelativePath(const SourceManager &SM) const;
+  std::string getOutputPath(const SourceManager &SM) const;
+  llvm::raw_fd_ostream &getOutput(const SourceManager &SM) const;
+  void closeOutput() const;
+  void addToManifest(const SourceManager &SM,
+                     const AnalysisManager &Mgr) const;
+};
+} // end anonymous namespace
+
+REGISTER_LIST_WITH_PROGRAMSTATE(EventList, SymExecEvent)
+
+// Same as SourceLocation::printWithoutColumn, but keeps the parts apart
+static void getCodeLocation(CheckerContext &C, const Stmt *S,
+                            std::string &File, unsigned &Line) {
+  SourceLocation Loc = S->getLocStart();
+  Line = 0;
+  if (!Loc.isValid()) {
+    File = "<invalid loc>";
+    return;
+  }
+
+  PresumedLoc PLoc = C.getSourceManager().getPresumedLoc(Loc);
+  if (PLoc.isInvalid()) {
+    File = "<invalid>";
+    return;
+  }
+  File = PLoc.getFilename();
+  Line = PLoc.getLine();
+}
+
+static std::string getFunctionName(const Decl *D) {
+  if (const NamedDecl *ND = dyn_cast<NamedDecl>(D))
+    return ND->getQualifiedNameAsString();
+  return std::string();
+}
+
+typedef SmallVector<std::pair<llvm::APSInt, llvm::APSInt>, 4> RangeList;
+
+static RangeList getRanges(ProgramStateRef State, SymbolRef Symbol) {
+  RangeList Ranges;
+  State->getStateManager().getConstraintManager()
+    .getSymbolRanges(State, Symbol, Ranges);
+  return Ranges;
+}
+
+static const void *getConstraintsID(ProgramStateRef State) {
+  return State->getStateManager().getConstraintManager()
+    .getConstraintsID(State);
+}
+
+static std::string getCond(ProgramStateRef State, SymbolRef Symbol,
+                           SymExecFilter &Filter) {
+  RangeList Ranges = getRanges(State, Symbol);
+  if (Ranges.empty())
+    return std::string();
+
+  std::string Result;
+  llvm::raw_string_ostream RS(Result);
+  SymTreePrinter(RS, State, nullptr, false, &Filter)
+    .printConstraint(Symbol, Ranges);
+  return RS.str();
+}
+
+namespace {
+// Nodes where the analysis of a function stopped before the end of their
+// path, with the TRUNCATED event saying why.
+typedef llvm::DenseMap<const ExplodedNode*, const SymExecEvent*> FrontierMap;
+
+// Bookkeeping for dumping one top-level function. In the graph output mode,
+// every event node gets an ID when it is emitted, and the IDs of the event
+// nodes directly below each visited ExplodedNode are kept so that later
+// visits become back-references. The binary output is always a graph.
+struct DumpState {
+  DumpState(const SymExecStringPool &Strings, const SymExecEventTable *Side,
+            const FrontierMap &Frontier, bool AsGraph, uint64_t Limit,
+            AsbWriter *Writer = nullptr)
+    : Strings(Strings), Side(Side), Frontier(Frontier),
+      AsGraph(AsGraph || Writer), Limit(Limit), Writer(Writer), NextID(0),
+      Truncated(false) {}
+
+  const SymExecStringPool &Strings;
+  // Events are in this table rather than in EventList, if not null
+  const SymExecEventTable *Side;
+  const FrontierMap &Frontier;
+  bool AsGraph;
+  // Stream position at which dumping stops (0: no limit)
+  uint64_t Limit;
+  // Binary output; node IDs are then record indices of the writer
+  AsbWriter *Writer;
+  unsigned NextID;
+  bool Truncated;
+  llvm::SmallPtrSet<const ExplodedNode*, 32> OnPath;
+  llvm::DenseMap<const ExplodedNode*, unsigned> IDs;
+  llvm::DenseMap<const ExplodedNode*, SmallVector<unsigned, 2> > Frontiers;
+};
+
+// An ExplodedNode on the current path, with the successors left to visit.
+struct DumpFrame {
+  DumpFrame(ExplodedNode *N, const SymExecEvent *Event, unsigned ID)
+    : N(N), Next(N->succ_begin()), Event(Event), ID(ID) {}
+
+  ExplodedNode *N;
+  ExplodedNode::succ_iterator Next;
+  // The event of N, if it is an event node
+  const SymExecEvent *Event;
+  unsigned ID;
+  // IDs of the event nodes emitted below N
+  SmallVector<unsigned, 2> Children;
+};
+
+typedef SmallVector<DumpFrame, 32> DumpStackTy;
+} // end anonymous namespace
+
+// Returns the event Cur adds to the path reached through Prev, if any.
+static const SymExecEvent *getEvent(const DumpState &DS,
+                                    const ExplodedNode *Cur,
+                                    const ExplodedNode *Prev) {
+  if (DS.Side)
+    return DS.Side->getEvent(Cur, Prev);
+
+  EventListTy CurEvents  = Cur->getState()->get<EventList>();
+  if (CurEvents.isEmpty())
+    return nullptr;
+  if (Prev) {
+    const EventListTy PrevEvents  = Prev->getState()->get<EventList>();
+    if (PrevEvents.isEqual(CurEvents))
+      return nullptr;
+  }
+  return &CurEvents.getHead();
+}
+
+static void dumpRef(llvm::raw_ostream &OS, unsigned ID) {
+  OS << "<REF ID=\"" << ID << "\"/>\n";
+}
+
+// Emits Cur as reached from Prev. IDs emitted at this level go to Frontier,
+// which may live in Stack, so it must not be touched after pushing a frame.
+static void enterNode(llvm::raw_ostream &OS,
+                      DumpState &DS,
+                      DumpStackTy &Stack,
+                      ExplodedNode *Cur,
+                      ExplodedNode *Prev,
+                      SmallVectorImpl<unsigned> &Frontier) {
+  ++NumNodesVisited;
+
+  // cycle
+  if (DS.OnPath.count(Cur))
+    return;
+
+  const SymExecEvent *Event = getEvent(DS, Cur, Prev);
+  bool valid = Event;
+
+  if (DS.AsGraph) {
+    if (valid) {
+      llvm::DenseMap<const ExplodedNode*, unsigned>::iterator I =
+        DS.IDs.find(Cur);
+      if (I != DS.IDs.end()) {
+        dumpRef(OS, I->second);
+        Frontier.push_back(I->second);
+        return;
+      }
+    }
+    else {
+      llvm::DenseMap<const ExplodedNode*, SmallVector<unsigned, 2> >::iterator
+        I = DS.Frontiers.find(Cur);
+      if (I != DS.Frontiers.end()) {
+        for (unsigned ID : I->second) {
+          dumpRef(OS, ID);
+          Frontier.push_back(ID);
+        }
+        return;
+      }
+    }
+  }
+
+  unsigned ID = 0;
+  if (valid && !DS.Writer) {
+    ++NumEventsEmitted;
+    OS << "<NODE";
+    if (DS.AsGraph) {
+      ID = DS.NextID++;
+      DS.IDs[Cur] = ID;
+      OS << " ID=\"" << ID << "\"";
+    }
+    OS << ">\n"
+       << "<EVENT>\n"
+       << Event->getAsString(DS.Strings)
+       << "\n" << "</EVENT>\n";
+  }
+
+  DS.OnPath.insert(Cur);
+  Stack.push_back(DumpFrame(Cur, Event, ID));
+}
+
+// Emits the TRUNCATED event of a frontier node below it.
+static void dumpTruncated(llvm::raw_ostream &OS,
+                          DumpState &DS,
+                          const SymExecEvent &Event,
+                          SmallVectorImpl<unsigned> &Children) {
+  ++NumEventsEmitted;
+  ++NumTruncatedEvents;
+  if (DS.Writer) {
+    Children.push_back(Event.writeTo(*DS.Writer, DS.Strings, None));
+    return;
+  }
+
+  OS << "<NODE";
+  if (DS.AsGraph) {
+    unsigned ID = DS.NextID++;
+    Children.push_back(ID);
+    OS << " ID=\"" << ID << "\"";
+  }
+  OS << ">\n"
+     << "<EVENT>\n"
+     << Event.getAsString(DS.Strings)
+     << "\n" << "</EVENT>\n"
+     << "</NODE>\n";
+}
+
+static void leaveNode(llvm::raw_ostream &OS,
+                      DumpState &DS,
+                      DumpStackTy &Stack,
+                      SmallVectorImpl<unsigned> &RootFrontier) {
+  DumpFrame &F = Stack.back();
+
+  FrontierMap::const_iterator I = DS.Frontier.find(F.N);
+  if (I != DS.Frontier.end())
+    dumpTruncated(OS, DS, *I->second, F.Children);
+
+  if (F.Event) {
+    if (DS.Writer) {
+      // records are written children first
+      ++NumEventsEmitted;
+      F.ID = F.Event->writeTo(*DS.Writer, DS.Strings, F.Children);
+      DS.IDs[F.N] = F.ID;
+    }
+    else
+      OS << "</NODE>\n";
+  }
+
+  if (DS.AsGraph) {
+    SmallVectorImpl<unsigned> &Frontier =
+      Stack.size() > 1 ? Stack[Stack.size() - 2].Children : RootFrontier;
+    if (F.Event)
+      Frontier.push_back(F.ID);
+    else
+      Frontier.append(F.Children.begin(), F.Children.end());
+    DS.Frontiers[F.N] = F.Children;
+  }
+
+  DS.OnPath.erase(F.N);
+  Stack.pop_back();
+}
+
+static void dumpTree(llvm::raw_ostream &OS,
+                     DumpState &DS,
+                     ExplodedNode *Root,
+                     SmallVectorImpl<unsigned> &Frontier) {
+  DumpStackTy Stack;
+
+  enterNode(OS, DS, Stack, Root, nullptr, Frontier);
+  while (!Stack.empty()) {
+    DumpFrame &F = Stack.back();
+    if (!DS.Truncated && F.Next != F.N->succ_end()) {
+      ExplodedNode *Succ = *F.Next++;
+      enterNode(OS, DS, Stack, Succ, F.N, F.Children);
+      uint64_t Pos = DS.Writer ? DS.Writer->tell() : OS.tell();
+      if (DS.Limit && Pos >= DS.Limit)
+        DS.Truncated = true;
+      continue;
+    }
+    // all successors are visited, or we are closing open nodes
+    leaveNode(OS, DS, Stack, Frontier);
+  }
+}
+
+static void printLimits(llvm::raw_ostream &OS, unsigned Limits) {
+  static const char *const Names[] = { "nodes", "time", "blocks", "aborted" };
+  const char *Sep = "";
+  for (unsigned i = 0; i != llvm::array_lengthof(Names); ++i) {
+    if (Limits & (1 << i)) {
+      OS << Sep << Names[i];
+      Sep = ",";
+    }
+  }
+}
+
+static void printBudget(llvm::raw_ostream &OS, const SymExecBudget &Budget) {
+  OS << " NODES=\"" << Budget.Nodes << "\"";
+  if (Budget.TimeMs)
+    OS << " TIME=\"" << Budget.TimeMs << "\"";
+  if (Budget.Limits) {
+    OS << " LIMITS=\"";
+    printLimits(OS, Budget.Limits);
+    OS << "\" FRONTIER=\"" << Budget.Frontier << "\"";
+  }
+}
+
+// Writes the XML report of one top-level function to OS.
+static void dumpReport(llvm::raw_ostream &OS, ExplodedGraph &G,
+                       const SymExecStringPool &Strings,
+                       const SymExecEventTable *Side,
+                       const FrontierMap &Frontier,
+                       const SymExecBudget &Budget,
+                       bool AsGraph, uint64_t MaxDumpBytes) {
+  uint64_t Start = OS.tell();
+  OS << "\n@SYM_EXEC_EXTRACTOR_BEGIN\n";
+  DumpState DS(Strings, Side, Frontier, AsGraph,
+               MaxDumpBytes ? Start + MaxDumpBytes : 0);
+  for (ExplodedGraph::roots_iterator I = G.roots_begin(), E = G.roots_end();
+      I != E; ++I) {
+    SmallVector<unsigned, 2> Frontier;
+    OS << "<TREE";
+    printBudget(OS, Budget);
+    OS << ">\n";
+    dumpTree(OS, DS, (*I), Frontier);
+    OS << "</TREE>\n";
+  }
+  OS << "\n@SYM_EXEC_EXTRACTOR_END\n";
+
+  NumBytesWritten += OS.tell() - Start;
+  if (DS.Truncated)
+    ++NumTruncatedDumps;
+}
+
+// SymExecPathWriter
+void SymExecPathWriter::addPath(ArrayRef<SymExecEvent> Path) {
+  uint64_t Pos = Writer ? Writer->tell() : OS.tell();
+  if (Limit && Pos >= Limit)
+    Truncated = true;
+  if (Truncated)
+    return;
+
+  size_t Common = 0;
+  while (Common != Open.size() && Common != Path.size() &&
+         Open[Common].Event == Path[Common])
+    ++Common;
+  // the same events as a path written before
+  if (Common == Path.size())
+    return;
+
+  while (Open.size() != Common)
+    closeEvent();
+  for (const SymExecEvent &Event : Path.slice(Common)) {
+    Open.push_back(OpenEvent(Event));
+    if (Writer)
+      continue;
+    ++NumEventsEmitted;
+    OS << "<NODE>\n"
+       << "<EVENT>\n"
+       << Event.getAsString(Strings)
+       << "\n" << "</EVENT>\n";
+  }
+}
+
+void SymExecPathWriter::closeEvent() {
+  OpenEvent &E = Open.back();
+  if (Writer) {
+    // records are written children first
+    ++NumEventsEmitted;
+    unsigned ID = E.Event.writeTo(*Writer, Strings, E.Children);
+    (Open.size() > 1 ? Open[Open.size() - 2].Children : Roots).push_back(ID);
+  }
+  else
+    OS << "</NODE>\n";
+  Open.pop_back();
+}
+
+ArrayRef<unsigned> SymExecPathWriter::finish() {
+  while (!Open.empty())
+    closeEvent();
+  return Roots;
+}
+
+// SymExecStringPool
+unsigned SymExecStringPool::intern(StringRef S) {
+  std::pair<llvm::StringMap<unsigned>::iterator, bool> R =
+    IDs.insert(std::make_pair(S, (unsigned)Strings.size()));
+  if (R.second)
+    Strings.push_back(R.first->getKey());
+  return R.first->getValue();
+}
+
+// SymExecEventTable
+const SymExecEvent *
+SymExecEventTable::getEvent(const ExplodedNode *Cur,
+                            const ExplodedNode *Prev) const {
+  llvm::DenseMap<const ExplodedNode*, SymExecEvent>::const_iterator I =
+    NodeEvents.find(Cur);
+  if (I != NodeEvents.end())
+    return &I->second;
+
+  // an assumption is made where the constraints change to the ones it
+  // produced
+  const void *ID = getConstraintsID(Cur->getState());
+  if (Prev && getConstraintsID(Prev->getState()) == ID)
+    return nullptr;
+  llvm::DenseMap<const void*, SmallVector<AssumeEvent, 1> >::const_iterator J =
+    AssumeEvents.find(ID);
+  if (J == AssumeEvents.end())
+    return nullptr;
+  const SmallVectorImpl<AssumeEvent> &Events = J->second;
+  if (!Prev)
+    return &Events.front().Event;
+  // Purging dead symbols can also lead back to constraints an assumption
+  // produced, without changing the ranges of its symbol
+  for (const AssumeEvent &AE : Events)
+    if (getRanges(Prev->getState(), AE.Sym) !=
+        getRanges(Cur->getState(), AE.Sym))
+      return &AE.Event;
+  return nullptr;
+}
+
+void SymExecEventTable::addAssumeEvent(ProgramStateRef State, SymbolRef Sym,
+                                       const SymExecEvent &E) {
+  SmallVectorImpl<AssumeEvent> &Events =
+    AssumeEvents[getConstraintsID(State)];
+  // the event of a symbol depends on its ranges alone
+  for (const AssumeEvent &AE : Events)
+    if (AE.Sym == Sym)
+      return;
+  AssumeEvent AE = { Sym, E };
+  Events.push_back(AE);
+  if (Events.size() == 1)
+    AssumedStates.push_back(State);
+}
+
+void SymExecEventTable::clear() {
+  NodeEvents.clear();
+  AssumeEvents.clear();
+  AssumedStates.clear();
+}
+
+// SymExecEvent
+SymExecEvent::SymExecEvent(Kind k) : K(k), File(0), Line(0), SV(0) {}
+
+SymExecEvent::SymExecEvent(Kind k, const Stmt* s, CheckerContext &C,
+                           SymExecStringPool &Strings, SymExecFilter &Filter)
+  : K(k), SV(0) {
+    std::string FileName;
+    getCodeLocation(C, s, FileName, Line);
+    File = Strings.intern(FileName);
+
+    switch (K) {
+      case FN_CALL: {
+        std::string Result;
+        llvm::raw_string_ostream OS(Result);
+        const CallExpr *CE = dyn_cast<CallExpr>(s);
+        assert(CE != nullptr);
+        SymTreePrinter Printer(OS, C.getState(), C.getLocationContext(), true,
+                               &Filter);
+        if (const SymExpr *SE = C.getSVal(CE).getAsSymbol(true))
+          Printer.printSymbol(SE);
+        else
+          Printer.printExpr(CE);
+        SV = Strings.intern(OS.str());
+        break;
+      }
+      default:
+        break;
+    }
+}
+
+SymExecEvent::SymExecEvent(Kind k, StringRef serialized,
+                           SymExecStringPool &Strings)
+  : K(k), File(0), Line(0) {
+    SV = Strings.intern(serialized);
+}
+
+std::string SymExecEvent::getKindAsXMLNode() const {
+  std::string Result;
+  llvm::raw_string_ostream OS(Result);
+  OS << "<KIND>";
+
+  switch (K){
+    case FN_CALL:
+      OS << "@LOG_CALL";
+      break;
+    case ASSUME:
+      OS << "@LOG_ASSUME";
+      break;
+    case EOP:
+      OS << "@LOG_EOP";
+      break;
+    case TRUNCATED:
+      OS << "@LOG_TRUNCATED";
+      break;
+  }
+
+  OS << "</KIND>";
+  return OS.str();
+}
+
+std::string
+SymExecEvent::getCodeAsXMLNode(const SymExecStringPool &Strings) const {
+  std::string Result;
+  llvm::raw_string_ostream OS(Result);
+  OS << "<CODE>" << Strings.get(File);
+  if (Line)
+    OS << ':' << Line;
+  OS << "</CODE>";
+  return OS.str();
+}
+
+unsigned SymExecEvent::writeTo(AsbWriter &W, const SymExecStringPool &Strings,
+                               ArrayRef<unsigned> Children) const {
+  switch (K) {
+    case FN_CALL:
+      return W.addCall(Strings.get(File), Line, Strings.get(SV), Children);
+    case ASSUME:
+      return W.addAssume(Strings.get(SV), Children);
+    case EOP:
+      return W.addEOP(Children);
+    case TRUNCATED:
+      break;
+  }
+  return W.addTruncated(Strings.get(SV), Children);
+}
+
+std::string
+SymExecEvent::getAsString(const SymExecStringPool &Strings) const {
+  std::string Result;
+  llvm::raw_string_ostream OS(Result);
+  LangOptions LO;
+
+  OS << getKindAsXMLNode();
+
+  switch (K) {
+    case FN_CALL:
+      OS << getCodeAsXMLNode(Strings);
+      OS << "<CALL>" << Strings.get(SV) << "</CALL>";
+      break;
+
+    case ASSUME:
+      OS << "<COND>" << Strings.get(SV) << "</COND>";
+      break;
+
+    case EOP:
+      break;
+
+    case TRUNCATED:
+      OS << "<REASON>" << Strings.get(SV) << "</REASON>";
+      break;
+  }
+
+  return OS.str();
+}
+
+void SymExecEvent::Profile(llvm::FoldingSetNodeID &ID) const {
+  // ImmutableList and the GDM tell events apart by their profile alone, so
+  // it has every field operator== compares. Equal strings have equal IDs.
+  ID.AddInteger(K);
+  ID.AddInteger(File);
+  ID.AddInteger(Line);
+  ID.AddInteger(SV);
+}
+
+// SymExecExtractor
+SymExecExtractor::SymExecExtractor(AnalyzerOptions &AO)
+  : StreamStart(0), NumFunctions(0), NumTrees(0),
+    NumFiltered(0), OutSize(0) {
+  StartTime = llvm::TimeRecord::getCurrentTime(true).getWallTime();
+  UseSideTable =
+    AO.getOptionAsString("apisan-event-trail", "state") == "side-table";
+  DumpAsGraph = AO.getBooleanOption("apisan-graph-output", true);
+  ExtractOnly = AO.AnalysisDiagOpt == PD_NONE;
+  PinCallReturns = AO.AnalysisPurgeOpt != PurgeNone;
+  MaxDumpBytes =
+    (uint64_t)AO.getOptionAsInteger("apisan-max-dump-mb", 1024) << 20;
+  DumpAsBinary = AO.getOptionAsString("apisan-output-format", "xml") == "asb";
+  StreamPaths = AO.getBooleanOption("apisan-stream-paths", false);
+  OutputFile = AO.getOptionAsString("apisan-output-file", "");
+  OutputDir = AO.getOptionAsString("apisan-output-dir", "");
+  TUKey = AO.getOptionAsString("apisan-tu-key", "");
+  ManifestPath = AO.getOptionAsString(
+      "apisan-manifest", OutputDir.empty() ? "" : OutputDir + "/manifest.jsonl");
+  if (DumpAsBinary && !writesToFile())
+    llvm::report_fatal_error("apisan-output-format=asb requires "
+                             "apisan-output-dir or apisan-output-file");
+  if (StreamPaths && UseSideTable)
+    llvm::report_fatal_error("apisan-stream-paths requires "
+                             "apisan-event-trail=state");
+  std::string FilterPath = AO.getOptionAsString("apisan-api-filter", "");
+  std::string Error;
+  if (!FilterPath.empty() && !Filter.loadFile(FilterPath, Error))
+    llvm::report_fatal_error("apisan-api-filter: " + Error);
+  SymExecExtractorReportType.reset(
+      new BugType(this,
+        "Return symbolic execution abstractions",
+        "Symbolic execution extractor"));
+}
+
+ProgramStateRef SymExecExtractor::evalAssume(ProgramStateRef State,
+    SVal Cond,
+    bool Assumption) const {
+  if (SymbolRef S = Cond.getAsSymbol()) {
+    if (const SymIntExpr *SIE = dyn_cast<SymIntExpr>(S)) {
+      std::string serialized = getCond(State, SIE->getLHS(), Filter);
+      if (!serialized.empty()) {
+        SymExecEvent E(SymExecEvent::ASSUME, serialized, Strings);
+        if (PinCallReturns)
+          pinCallReturn(SIE->getLHS());
+        if (UseSideTable) {
+          SideEvents.addAssumeEvent(State, SIE->getLHS(), E);
+          return State;
+        }
+        ProgramStateRef NewState = State->add<EventList>(E);
+        return NewState;
+      }
+    }
+  }
+  return State;
+}
+
+void SymExecExtractor::checkPostStmt(const CallExpr *CE,
+                                     CheckerContext &C) const {
+  if (filterCall(C.getCalleeDecl(CE)) == SymExecFilter::Ignore)
+    return;
+
+  SymExecEvent E(SymExecEvent::FN_CALL, CE, C, Strings, Filter);
+  addEvent(C, C.getState(), E);
+}
+
+void SymExecExtractor::pinCallReturn(SymbolRef Sym) const {
+  // Pointers are returned as symbolic regions of the conjured symbol, which
+  // are tested as the symbol itself
+  const SymbolConjured *SC = dyn_cast<SymbolConjured>(Sym);
+  if (SC && SC->getStmt() && isa<CallExpr>(SC->getStmt()) &&
+      PinnedSymbols.insert(SC).second)
+    ++NumPinnedSymbols;
+}
+
+void SymExecExtractor::checkLiveSymbols(ProgramStateRef State,
+                                        SymbolReaper &SR) const {
+  // Derived symbols, symbolic expressions and symbolic regions of a live
+  // symbol are live as well (see SymbolReaper::isLive)
+  for (SymbolRef Sym : PinnedSymbols)
+    SR.markLive(Sym);
+}
+
+void SymExecExtractor::checkEndFunction(CheckerContext &C) const {
+  if (!C.getLocationContext()->inTopFrame())
+    return;
+
+  ExplodedNode *N =
+    addEvent(C, C.getState(), SymExecEvent(SymExecEvent::EOP));
+  // No node is made if the path reached the same state before, and was
+  // written then
+  if (StreamPaths && N)
+    streamPath(C.getSourceManager(), N);
+}
+
+ExplodedNode *SymExecExtractor::addEvent(CheckerContext &C,
+                                         ProgramStateRef State,
+                                         const SymExecEvent &E) const {
+  if (!UseSideTable) {
+    ProgramStateRef NewState = State->add<EventList>(E);
+    return C.addTransition(NewState);
+  }
+
+  // The tag makes a node even if the state is unchanged. If the node
+  // exists already, it is the same event reached by another path.
+  static CheckerProgramPointTag Tag(this, "SymExecEvent");
+  ExplodedNode *N = C.addTransition(State, &Tag);
+  if (N)
+    SideEvents.NodeEvents.insert(std::make_pair(N, E));
+  return N;
+}
+
+void SymExecExtractor::checkEndAnalysis(ExplodedGraph &G,
+                                         BugReporter &BR,
+                                         ExprEngine &N) const {
+  NumGraphNodes += G.size();
+  MaxGraphNodes = MaxGraphNodes < G.size() ? G.size() : MaxGraphNodes;
+
+  if (StreamPaths)
+    finishPaths(G, BR, N);
+  else
+    dumpPaths(G, BR, N);
+  SideEvents.clear();
+  PinnedSymbols.clear();
+}
+
+namespace {
+// Collects the nodes left on the worklist when a budget stopped the engine.
+class WorkListFrontier : public WorkList::Visitor {
+  FrontierMap &Frontier;
+  const SymExecEvent *Event;
+
+public:
+  WorkListFrontier(FrontierMap &Frontier, const SymExecEvent *Event)
+    : Frontier(Frontier), Event(Event) {}
+
+  bool visit(const WorkListUnit &U) override {
+    Frontier.insert(std::make_pair(U.getNode(), Event));
+    return false;
+  }
+};
+} // end anonymous namespace
+
+// Finds where the analysis of the function stopped before the end of a
+// path: the worklist left by max-nodes or max-time, the blocks visited too
+// often on a path and the statements the engine gave up on.
+static void getFrontier(ExprEngine &Eng, SymExecStringPool &Strings,
+                        FrontierMap &Frontier, SymExecBudget &Budget,
+                        std::vector<SymExecEvent> &Events) {
+  Events.push_back(SymExecEvent(SymExecEvent::TRUNCATED, "nodes", Strings));
+  Events.push_back(SymExecEvent(SymExecEvent::TRUNCATED, "time", Strings));
+  Events.push_back(SymExecEvent(SymExecEvent::TRUNCATED, "blocks", Strings));
+  Events.push_back(SymExecEvent(SymExecEvent::TRUNCATED, "aborted", Strings));
+
+  const CoreEngine &Engine = Eng.getCoreEngine();
+  Budget.Nodes = Eng.getGraph().size();
+  // Time is recorded only under a time budget, so that the output of an
+  // analysis without one is the same from run to run
+  if (Eng.getAnalysisManager().options.getMaxTimePerTopLevelFunction())
+    Budget.TimeMs = (uint64_t)(Engine.getTimeSpent() * 1000);
+
+  if (Engine.getStoppedBy() != CoreEngine::WLL_None) {
+    bool ByTime = Engine.getStoppedBy() == CoreEngine::WLL_MaxTime;
+    Budget.Limits |= ByTime ? SymExecBudget::L_Time : SymExecBudget::L_Nodes;
+    WorkListFrontier V(Frontier, &Events[ByTime ? 1 : 0]);
+    Engine.getWorkList()->visitItemsInWorkList(V);
+  }
+  for (CoreEngine::BlocksExhausted::const_iterator
+      I = Engine.blocks_exhausted_begin(),
+      E = Engine.blocks_exhausted_end(); I != E; ++I) {
+    Budget.Limits |= SymExecBudget::L_Blocks;
+    Frontier.insert(std::make_pair(I->second, &Events[2]));
+  }
+  for (CoreEngine::BlocksAborted::const_iterator
+      I = Engine.blocks_aborted_begin(),
+      E = Engine.blocks_aborted_end(); I != E; ++I) {
+    Budget.Limits |= SymExecBudget::L_Aborted;
+    Frontier.insert(std::make_pair(I->second, &Events[3]));
+  }
+
+  Budget.Frontier = Frontier.size();
+  if (Budget.Limits)
+    ++NumBudgetExhausted;
+}
+
+void SymExecExtractor::dumpPaths(ExplodedGraph &G, BugReporter &BR,
+                                 ExprEngine &Eng) const {
+  const ExplodedNode *GraphRoot = *G.roots_begin();
+  const LocationContext *LC = GraphRoot->getLocation().getLocationContext();
+  const Decl *D = LC->getDecl();
+  const SourceManager &SM = BR.getSourceManager();
+
+  FrontierMap Frontier;
+  SymExecBudget Budget;
+  std::vector<SymExecEvent> TruncatedEvents;
+  getFrontier(Eng, Strings, Frontier, Budget, TruncatedEvents);
+
+  ++NumFunctions;
+  NumTrees += G.num_roots();
+  if (DumpAsBinary) {
+    getOutput(SM);
+    AsbWriter &W = *DB;
+    uint64_t Start = W.tell();
+    DumpState DS(Strings, getSideEvents(), Frontier, true,
+                 MaxDumpBytes ? Start + MaxDumpBytes : 0, &W);
+    SmallVector<unsigned, 2> Roots;
+    for (ExplodedGraph::roots_iterator I = G.roots_begin(),
+        E = G.roots_end(); I != E; ++I)
+      dumpTree(llvm::nulls(), DS, (*I), Roots);
+    W.addFunction(getFunctionName(D), Roots, Budget);
+
+    NumBytesWritten += W.tell() - Start;
+    if (DS.Truncated)
+      ++NumTruncatedDumps;
+    return;
+  }
+
+  // stream the report into the database file
+  if (writesToFile()) {
+    dumpReport(getOutput(SM), G, Strings, getSideEvents(), Frontier, Budget,
+               DumpAsGraph, MaxDumpBytes);
+    return;
+  }
+
+  if (ExtractOnly) {
+    llvm::raw_fd_ostream &OS = getReportStream(SM);
+    OS << "###: ";
+    dumpReport(OS, G, Strings, getSideEvents(), Frontier, Budget, DumpAsGraph,
+               MaxDumpBytes);
+    OS << "\n";
+    OS.flush();
+    return;
+  }
+
+  std::string Report;
+  llvm::raw_string_ostream OS(Report);
+  dumpReport(OS, G, Strings, getSideEvents(), Frontier, Budget, DumpAsGraph,
+             MaxDumpBytes);
+
+  llvm::errs() << "###: " << OS.str() << "\n";
+  BugReport *R = new BugReport(*SymExecExtractorReportType, OS.str(),
+                                PathDiagnosticLocation(D, SM));
+  BR.emitReport(R);
+}
+
+llvm::raw_fd_ostream &
+SymExecExtractor::getReportStream(const SourceManager &SM) const {
+  if (writesToFile())
+    return getOutput(SM);
+  if (!ErrStream)
+    ErrStream.reset(new llvm::raw_fd_ostream(2, /*shouldClose=*/false));
+  return *ErrStream;
+}
+
+// Starts the report of the function being analyzed, when its first path ends.
+SymExecPathWriter &
+SymExecExtractor::getPathWriter(const SourceManager &SM) const {
+  if (PathWriter)
+    return *PathWriter;
+
+  if (DumpAsBinary) {
+    getOutput(SM);
+    StreamStart = DB->tell();
+    PathWriter.reset(new SymExecPathWriter(llvm::nulls(), Strings, DB.get(),
+        MaxDumpBytes ? StreamStart + MaxDumpBytes : 0));
+    return *PathWriter;
+  }
+
+  llvm::raw_fd_ostream &OS = getReportStream(SM);
+  if (!writesToFile())
+    OS << "###: ";
+  StreamStart = OS.tell();
+  OS << "\n@SYM_EXEC_EXTRACTOR_BEGIN\n<TREE>\n";
+  PathWriter.reset(new SymExecPathWriter(OS, Strings, nullptr,
+      MaxDumpBytes ? StreamStart + MaxDumpBytes : 0));
+  return *PathWriter;
+}
+
+static void getPath(const ExplodedNode *N,
+                    SmallVectorImpl<SymExecEvent> &Path) {
+  for (const SymExecEvent &E : N->getState()->get<EventList>())
+    Path.push_back(E);
+  // the list has the last event first
+  std::reverse(Path.begin(), Path.end());
+}
+
+void SymExecExtractor::streamPath(const SourceManager &SM,
+                                  const ExplodedNode *N) const {
+  SmallVector<SymExecEvent, 32> Path;
+  getPath(N, Path);
+  getPathWriter(SM).addPath(Path);
+}
+
+// Writes the paths cut by a budget and closes the report of the function.
+void SymExecExtractor::finishPaths(ExplodedGraph &G, BugReporter &BR,
+                                   ExprEngine &Eng) const {
+  const ExplodedNode *GraphRoot = *G.roots_begin();
+  const Decl *D = GraphRoot->getLocation().getLocationContext()->getDecl();
+  const SourceManager &SM = BR.getSourceManager();
+
+  FrontierMap Frontier;
+  SymExecBudget Budget;
+  std::vector<SymExecEvent> TruncatedEvents;
+  getFrontier(Eng, Strings, Frontier, Budget, TruncatedEvents);
+
+  ++NumFunctions;
+  NumTrees += G.num_roots();
+  SymExecPathWriter &PW = getPathWriter(SM);
+
+  // sorted, so that the output does not depend on addresses and common
+  // events are next to each other
+  std::vector<SmallVector<SymExecEvent, 32> > CutPaths(Frontier.size());
+  unsigned i = 0;
+  for (FrontierMap::const_iterator I = Frontier.begin(), E = Frontier.end();
+       I != E; ++I, ++i) {
+    getPath(I->first, CutPaths[i]);
+    CutPaths[i].push_back(*I->second);
+  }
+  std::sort(CutPaths.begin(), CutPaths.end());
+  for (const SmallVector<SymExecEvent, 32> &Path : CutPaths)
+    PW.addPath(Path);
+
+  ArrayRef<unsigned> Roots = PW.finish();
+  if (PW.isTruncated())
+    ++NumTruncatedDumps;
+  if (DumpAsBinary) {
+    DB->addFunction(getFunctionName(D), Roots, Budget);
+    NumBytesWritten += DB->tell() - StreamStart;
+  }
+  else {
+    // the budget is known only now, so it follows the paths
+    llvm::raw_fd_ostream &OS = getReportStream(SM);
+    OS << "<BUDGET";
+    printBudget(OS, Budget);
+    OS << "/>\n"
+       << "</TREE>\n"
+       << "\n@SYM_EXEC_EXTRACTOR_END\n";
+    NumBytesWritten += OS.tell() - StreamStart;
+    if (!writesToFile()) {
+      OS << "\n";
+      OS.flush();
+    }
+  }
+  PathWriter.reset();
+}
+
+void SymExecExtractor::checkEndOfTranslationUnit(const TranslationUnitDecl *TU,
+                                                 AnalysisManager &Mgr,
+                                                 BugReporter &BR) const {
+  const SourceManager &SM = BR.getSourceManager();
+  // A translation unit without paths has no database; drop the one of an
+  // earlier run instead of leaving it behind
+  if (!OutStream && !OutputDir.empty() && OutputFile.empty())
+    llvm::sys::fs::remove(getOutputPath(SM));
+  closeOutput();
+  if (!ManifestPath.empty())
+    addToManifest(SM, Mgr);
+}
+
+static SmallString<128> getMainFile(const SourceManager &SM) {
+  SmallString<128> Main("unknown");
+  if (const FileEntry *FE = SM.getFileEntryForID(SM.getMainFileID())) {
+    Main = FE->getName();
+    llvm::sys::fs::make_absolute(Main);
+  }
+  return Main;
+}
+
+StringRef SymExecExtractor::getTUKey(const SourceManager &SM) const {
+  if (TUKey.empty()) {
+    llvm::MD5 Hash;
+    llvm::MD5::MD5Result Result;
+    Hash.update(getMainFile(SM));
+    Hash.final(Result);
+    SmallString<32> Hex;
+    llvm::MD5::stringifyResult(Result, Hex);
+    TUKey = Hex.str();
+  }
+  return TUKey;
+}
+
+// Databases are spread over 256 directories by the first byte of their key,
+// so that translation units with the same file name never collide.
+std::string SymExecExtractor::getRelativePath(const SourceManager &SM) const {
+  StringRef Key = getTUKey(SM);
+  SmallString<64> Path(Key.substr(0, 2));
+  llvm::sys::path::append(Path, Key);
+  Path += DumpAsBinary ? ".asb" : ".as";
+  return Path.str();
+}
+
+std::string SymExecExtractor::getOutputPath(const SourceManager &SM) const {
+  if (!OutputFile.empty())
+    return OutputFile;
+
+  SmallString<128> Path(OutputDir);
+  llvm::sys::path::append(Path, getRelativePath(SM));
+  return Path.str();
+}
+
+static void printJSONString(raw_ostream &OS, StringRef S) {
+  OS << '"';
+  for (unsigned char C : S) {
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << llvm::format("\\u%04x", C);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+// Peak resident set size of the process in KB, 0 if unknown. Each
+// translation unit is analyzed by a process of its own (clang -cc1 or a
+// worker of apisan-extract), so this is the peak of the translation unit.
+static uint64_t getPeakRSS() {
+#ifdef LLVM_ON_UNIX
+  struct rusage RU;
+  if (::getrusage(RUSAGE_SELF, &RU) == 0)
+#ifdef __APPLE__
+    return RU.ru_maxrss >> 10;
+#else
+    return RU.ru_maxrss;
+#endif
+#endif
+  return 0;
+}
+
+// Appends one JSON record per translation unit to the manifest, which the
+// checkers read instead of walking the database directory. The record is
+// written at once to a file opened for appending, so that concurrent
+// compilers do not interleave their records. Functions of headers left to
+// other translation units (apisan-dedup-dir) are listed with their owner.
+void SymExecExtractor::addToManifest(const SourceManager &SM,
+                                     const AnalysisManager &Mgr) const {
+  double Time =
+    llvm::TimeRecord::getCurrentTime(false).getWallTime() - StartTime;
+
+  std::string Record;
+  llvm::raw_string_ostream OS(Record);
+  OS << "{\"key\": ";
+  printJSONString(OS, getTUKey(SM));
+  OS << ", \"source\": ";
+  printJSONString(OS, getMainFile(SM));
+  OS << ", \"file\": ";
+  printJSONString(OS, OutSize ? getRelativePath(SM) : "");
+  OS << ", \"size\": " << OutSize
+     << ", \"functions\": " << NumFunctions
+     << ", \"trees\": " << NumTrees
+     << ", \"filtered\": " << NumFiltered
+     << ", \"time\": " << llvm::format("%.3f", Time)
+     << ", \"maxrss\": " << getPeakRSS();
+  if (!Mgr.DeduplicatedFunctions.empty()) {
+    OS << ", \"deduplicated\": [";
+    for (unsigned i = 0, e = Mgr.DeduplicatedFunctions.size(); i != e; ++i) {
+      OS << (i ? ", " : "") << "{\"function\": ";
+      printJSONString(OS, Mgr.DeduplicatedFunctions[i].first);
+      OS << ", \"owner\": ";
+      printJSONString(OS, Mgr.DeduplicatedFunctions[i].second);
+      OS << '}';
+    }
+    OS << ']';
+  }
+  OS << "}\n";
+  OS.flush();
+
+  StringRef Dir = llvm::sys::path::parent_path(ManifestPath);
+  std::error_code EC;
+  if (!Dir.empty())
+    EC = llvm::sys::fs::create_directories(Dir);
+  if (!EC) {
+    llvm::raw_fd_ostream Manifest(ManifestPath, EC, llvm::sys::fs::F_Append);
+    if (!EC) {
+      Manifest.write(Record.data(), Record.size());
+      Manifest.close();
+      if (Manifest.has_error()) {
+        Manifest.clear_error();
+        EC = std::make_error_code(std::errc::io_error);
+      }
+    }
+  }
+  if (EC)
+    llvm::report_fatal_error("cannot write " + ManifestPath + ": " +
+                             EC.message());
+}
+
+llvm::raw_fd_ostream &
+SymExecExtractor::getOutput(const SourceManager &SM) const {
+  if (OutStream)
+    return *OutStream;
+
+  OutPath = getOutputPath(SM);
+  StringRef Dir = llvm::sys::path::parent_path(OutPath);
+  std::error_code EC;
+  if (!Dir.empty())
+    EC = llvm::sys::fs::create_directories(Dir);
+
+  int FD;
+  if (!EC)
+    EC = llvm::sys::fs::createUniqueFile(OutPath + ".tmp-%%%%%%", FD,
+                                         TempPath);
+  if (EC)
+    llvm::report_fatal_error("cannot open " + OutPath + ": " + EC.message());
+
+  // raw_fd_ostream buffers the output, so nothing is kept in memory
+  OutStream.reset(new llvm::raw_fd_ostream(FD, /*shouldClose=*/true));
+  if (DumpAsBinary)
+    DB.reset(new AsbWriter(*OutStream));
+  return *OutStream;
+}
+
+void SymExecExtractor::closeOutput() const {
+  if (!OutStream)
+    return;
+
+  if (DB) {
+    DB->finish();
+    DB.reset();
+  }
+  OutSize = OutStream->tell();
+  OutStream->close();
+  bool Failed = OutStream->has_error();
+  if (Failed)
+    OutStream->clear_error();
+  OutStream.reset();
+
+  if (Failed) {
+    llvm::sys::fs::remove(TempPath.str());
+    llvm::report_fatal_error("cannot write " + OutPath);
+  }
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath.str(), OutPath)) {
+    llvm::sys::fs::remove(TempPath.str());
+    llvm::report_fatal_error("cannot rename " + TempPath.str() + " to " +
+                             OutPath + ": " + EC.message());
+  }
+}
+
+SymExecFilter::Action
+SymExecExtractor::filterCall(const FunctionDecl *FD) const {
+  if (!FD)
+    return SymExecFilter::Record;
+
+  SymExecFilter::Action A = Filter.getAction(FD);
+  switch (A) {
+    case SymExecFilter::Record:
+      return A;
+    case SymExecFilter::NoArgs:
+      ++NumCallsWithoutArgs;
+      break;
+    case SymExecFilter::Ignore:
+      ++NumCallsIgnored;
+      break;
+  }
+  ++NumFiltered;
+  return A;
+}
+
+void ento::registerSymExecExtractor(CheckerManager &mgr) {
+  mgr.registerChecker<SymExecExtractor>(mgr.getAnalyzerOptions());
+}
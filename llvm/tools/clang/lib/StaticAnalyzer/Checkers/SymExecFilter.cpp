@@ -0,0 +1,170 @@
+//=== SymExecFilter.cpp - Callee filter for SymExecExtractor ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines SymExecFilter. Names and prefixes are looked up in hash
+// tables, one lookup per prefix length, and globs are compiled into regular
+// expressions. The action of a callee is kept, so each callee is matched
+// once per translation unit.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymExecFilter.h"
+#include "clang/AST/Decl.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <algorithm>
+#include <functional>
+
+using namespace clang;
+using namespace ento;
+
+SymExecFilter::SymExecFilter() {
+  Names["__builtin_expect"] = Ignore;
+}
+
+bool SymExecFilter::loadFile(StringRef Path, std::string &Error) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > Buf =
+    llvm::MemoryBuffer::getFile(Path);
+  if (!Buf) {
+    Error = Path.str() + ": " + Buf.getError().message();
+    return false;
+  }
+
+  SmallVector<StringRef, 64> Lines;
+  (*Buf)->getBuffer().split(Lines, "\n");
+  for (unsigned i = 0, e = Lines.size(); i != e; ++i) {
+    if (!addRule(Lines[i], Error)) {
+      Error = Path.str() + ":" + llvm::utostr(i + 1) + ": " + Error;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same as the glob of a shell: '*', '?' and '[...]' (or '[!...]')
+static std::string globToRegex(StringRef Glob) {
+  std::string RE = "^";
+  for (size_t i = 0, e = Glob.size(); i != e; ++i) {
+    char C = Glob[i];
+    switch (C) {
+      case '*':
+        RE += ".*";
+        break;
+      case '?':
+        RE += '.';
+        break;
+      case '[': {
+        size_t End = Glob.find(']', i + 1);
+        if (End == StringRef::npos) {
+          RE += "\\[";
+          break;
+        }
+        StringRef Set = Glob.slice(i + 1, End);
+        RE += '[';
+        if (Set.startswith("!")) {
+          RE += '^';
+          Set = Set.drop_front();
+        }
+        RE += Set;
+        RE += ']';
+        i = End;
+        break;
+      }
+      default:
+        if (StringRef("\\^$.|+(){}").find(C) != StringRef::npos)
+          RE += '\\';
+        RE += C;
+        break;
+    }
+  }
+  RE += '$';
+  return RE;
+}
+
+bool SymExecFilter::addRule(StringRef Line, std::string &Error) {
+  Line = Line.split('#').first.trim();
+  if (Line.empty())
+    return true;
+
+  size_t Sep = Line.find_first_of(" \t");
+  std::pair<StringRef, StringRef> Rule(Line.substr(0, Sep),
+                                       Line.substr(Sep));
+  StringRef Pattern = Rule.second.trim();
+  Action A;
+  if (Rule.first == "record")
+    A = Record;
+  else if (Rule.first == "noargs")
+    A = NoArgs;
+  else if (Rule.first == "ignore")
+    A = Ignore;
+  else {
+    Error = "unknown action '" + Rule.first.str() + "'";
+    return false;
+  }
+  if (Pattern.empty() || Pattern.find_first_of(" \t") != StringRef::npos) {
+    Error = "expected one pattern after '" + Rule.first.str() + "'";
+    return false;
+  }
+
+  StringRef Prefix = Pattern;
+  if (Prefix.endswith("*"))
+    Prefix = Prefix.drop_back();
+  if (Prefix.find_first_of("*?[") == StringRef::npos) {
+    if (Prefix.size() == Pattern.size()) {
+      Names[Pattern] = A;
+      return true;
+    }
+    Prefixes[Prefix] = A;
+    if (std::find(PrefixLengths.begin(), PrefixLengths.end(),
+                  Prefix.size()) == PrefixLengths.end()) {
+      PrefixLengths.push_back(Prefix.size());
+      std::sort(PrefixLengths.begin(), PrefixLengths.end(),
+                std::greater<size_t>());
+    }
+    return true;
+  }
+
+  std::unique_ptr<llvm::Regex> RE(new llvm::Regex(globToRegex(Pattern)));
+  if (!RE->isValid(Error))
+    return false;
+  Globs.push_back(std::make_pair(std::move(RE), A));
+  return true;
+}
+
+SymExecFilter::Action SymExecFilter::getAction(StringRef Name) {
+  llvm::StringMap<Action>::const_iterator I = Names.find(Name);
+  if (I != Names.end())
+    return I->getValue();
+
+  for (size_t Len : PrefixLengths) {
+    if (Len > Name.size())
+      continue;
+    I = Prefixes.find(Name.substr(0, Len));
+    if (I != Prefixes.end())
+      return I->getValue();
+  }
+
+  for (auto &G : Globs)
+    if (G.first->match(Name))
+      return G.second;
+  return Record;
+}
+
+SymExecFilter::Action SymExecFilter::getAction(const FunctionDecl *FD) {
+  FD = FD->getCanonicalDecl();
+  llvm::DenseMap<const FunctionDecl*, Action>::const_iterator I =
+    Decided.find(FD);
+  if (I != Decided.end())
+    return I->second;
+
+  // the name calls are printed with, see SymTreePrinter
+  Action A = getAction(FD->getNameInfo().getAsString());
+  Decided[FD] = A;
+  return A;
+}
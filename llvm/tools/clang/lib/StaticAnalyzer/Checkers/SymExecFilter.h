@@ -0,0 +1,80 @@
+//=== SymExecFilter.h - Callee filter for SymExecExtractor ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Declares SymExecFilter, which decides per callee whether SymExecExtractor
+// records a call (apisan-api-filter). A filter file has one rule per line:
+//
+//   <action> <pattern>
+//
+// where <action> is
+//   record   record the call (the default for callees without a rule)
+//   noargs   record the call without its arguments
+//   ignore   record nothing
+//
+// and <pattern>, separated from it by spaces or tabs, is a name, a prefix
+// ending with '*', or a glob with '*', '?' and '[...]'. A name wins over a
+// prefix, a longer prefix over a shorter one, and a prefix over a glob; globs
+// are tried in the order of the file, and a later rule for the same name or
+// prefix replaces an earlier one. '#' starts a comment. __builtin_expect is
+// ignored unless a rule says otherwise.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_STATICANALYZER_CHECKERS_SYMEXECFILTER_H
+#define LLVM_CLANG_LIB_STATICANALYZER_CHECKERS_SYMEXECFILTER_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Regex.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clang {
+class FunctionDecl;
+
+namespace ento {
+
+class SymExecFilter {
+public:
+  enum Action {
+    Record,
+    NoArgs,
+    Ignore
+  };
+
+  SymExecFilter();
+
+  /// \brief Adds the rules of the file \p Path. Returns false and sets
+  /// \p Error if it cannot be read or has a malformed rule.
+  bool loadFile(StringRef Path, std::string &Error);
+
+  /// \brief Adds the rule \p Line (in the syntax of a filter file).
+  bool addRule(StringRef Line, std::string &Error);
+
+  Action getAction(StringRef Name);
+
+  /// \brief Returns the action for the callee \p FD, which is matched once.
+  Action getAction(const FunctionDecl *FD);
+
+private:
+  llvm::StringMap<Action> Names;
+  llvm::StringMap<Action> Prefixes;
+  // Lengths of the prefixes in Prefixes, longest first
+  std::vector<size_t> PrefixLengths;
+  std::vector<std::pair<std::unique_ptr<llvm::Regex>, Action> > Globs;
+  llvm::DenseMap<const FunctionDecl*, Action> Decided;
+};
+
+} // end namespace ento
+} // end namespace clang
+
+#endif
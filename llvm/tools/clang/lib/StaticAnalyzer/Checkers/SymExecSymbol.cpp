@@ -0,0 +1,412 @@
+//=== SymExecSymbol.cpp - Structured symbols for SymExecExtractor -*- C++ -*-=//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines SymTreePrinter. It follows what AsStmtPrinter and the
+// FSS_FORMAT dumpToStream methods of symbols, values and regions print, but
+// keeps the structure.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymExecSymbol.h"
+#include "SymExecFilter.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Expr.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/AsStmtPrinter.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/MemRegion.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/SymbolManager.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+using namespace ento;
+
+static void printAttr(raw_ostream &OS, StringRef Name, StringRef Value) {
+  OS << ' ' << Name << "=\"";
+  for (char C : Value) {
+    switch (C) {
+      case '&': OS << "&amp;"; break;
+      case '<': OS << "&lt;"; break;
+      case '>': OS << "&gt;"; break;
+      case '"': OS << "&quot;"; break;
+      default: OS << C; break;
+    }
+  }
+  OS << '"';
+}
+
+static void printInt(raw_ostream &OS, const llvm::APSInt &V) {
+  OS << "<SYM K=\"int\" V=\"" << V.toString(10) << "\"/>";
+}
+
+static void printText(raw_ostream &OS, StringRef Text) {
+  OS << "<SYM K=\"text\"";
+  printAttr(OS, "V", Text);
+  OS << "/>";
+}
+
+template <typename T>
+static void printDumpAsText(raw_ostream &OS, const T &Obj) {
+  std::string Text;
+  llvm::raw_string_ostream TS(Text);
+  Obj.dumpToStream(TS);
+  printText(OS, TS.str());
+}
+
+void SymTreePrinter::printText(const Expr *E) {
+  std::string Text;
+  llvm::raw_string_ostream TS(Text);
+  if (Conjured)
+    AsStmtPrinter(TS, Conjured, 0, LValue).Visit(const_cast<Expr*>(E));
+  else
+    AsStmtPrinter(TS, LCtx, State, 0, LValue).Visit(const_cast<Expr*>(E));
+  ::printText(OS, TS.str());
+}
+
+SVal SymTreePrinter::getValue(const Expr *E) const {
+  if (Conjured)
+    return Conjured->getSubExprVal(E);
+  return State->getSVal(E, LCtx);
+}
+
+// Same as AsStmtPrinter::tryToEvalSymExprOrSVal
+bool SymTreePrinter::tryToPrintValue(const Expr *E) {
+  SVal V = getValue(E);
+  if (V.isUnknownOrUndef())
+    return false;
+
+  if (LValue) {
+    if (const SymExpr *SE = V.getAsSymExpr()) {
+      if (isa<SymbolConjured>(SE))
+        return false;
+      printSymbol(SE);
+      return true;
+    }
+  }
+
+#ifndef FSS_DISABLE_ADOHC_WORKAROUND_FOR_CLANG_BUG
+  if (V.getBaseKind() == SVal::LocKind &&
+      V.getSubKind() == loc::MemRegionKind)
+    return false;
+#endif
+  printSVal(V);
+  return true;
+}
+
+void SymTreePrinter::printExpr(const Expr *E) {
+  // want to print sizeof(buf), not just an integer, as AsStmtPrinter does
+  if (isa<UnaryExprOrTypeTraitExpr>(E->IgnoreParenCasts()) ||
+      !tryToPrintValue(E))
+    printStructure(E);
+}
+
+void SymTreePrinter::printStructure(const Expr *E) {
+  switch (E->getStmtClass()) {
+    case Stmt::CallExprClass: {
+      const CallExpr *CE = cast<CallExpr>(E);
+      const FunctionDecl *FD = CE->getDirectCallee();
+      if (!FD)
+        break;
+      OS << "<SYM K=\"call\"";
+      printAttr(OS, "N", FD->getNameInfo().getAsString());
+      OS << '>';
+      unsigned NumArgs = CE->getNumArgs();
+      if (Filter && Filter->getAction(FD) == SymExecFilter::NoArgs)
+        NumArgs = 0;
+      for (unsigned i = 0; i != NumArgs; ++i) {
+        // Don't print any defaulted arguments
+        if (isa<CXXDefaultArgExpr>(CE->getArg(i)))
+          break;
+        printExpr(CE->getArg(i));
+      }
+      OS << "</SYM>";
+      return;
+    }
+
+    case Stmt::DeclRefExprClass: {
+      const DeclRefExpr *DRE = cast<DeclRefExpr>(E);
+      if (DRE->getQualifier() || DRE->hasExplicitTemplateArgs())
+        break;
+      OS << "<SYM K=\"id\"";
+      printAttr(OS, "N", DRE->getNameInfo().getAsString());
+      OS << "/>";
+      return;
+    }
+
+    case Stmt::IntegerLiteralClass: {
+      const IntegerLiteral *IL = cast<IntegerLiteral>(E);
+      printInt(OS, llvm::APSInt(IL->getValue(),
+                                !IL->getType()->isSignedIntegerType()));
+      return;
+    }
+
+    case Stmt::StringLiteralClass: {
+      std::string Str;
+      llvm::raw_string_ostream SS(Str);
+      cast<StringLiteral>(E)->outputString(SS);
+      OS << "<SYM K=\"str\"";
+      printAttr(OS, "V", SS.str());
+      OS << "/>";
+      return;
+    }
+
+    case Stmt::ParenExprClass:
+      printExpr(cast<ParenExpr>(E)->getSubExpr());
+      return;
+
+    case Stmt::ImplicitCastExprClass:
+    case Stmt::CStyleCastExprClass:
+      printExpr(cast<CastExpr>(E)->getSubExpr());
+      return;
+
+    case Stmt::UnaryOperatorClass: {
+      // the address of a value is printed as the value
+      const UnaryOperator *UO = cast<UnaryOperator>(E);
+      if (UO->getOpcode() != UO_AddrOf)
+        break;
+      printExpr(UO->getSubExpr());
+      return;
+    }
+
+    case Stmt::ArraySubscriptExprClass: {
+      const ArraySubscriptExpr *ASE = cast<ArraySubscriptExpr>(E);
+      OS << "<SYM K=\"array\">";
+      printExpr(ASE->getLHS());
+      printExpr(ASE->getRHS());
+      OS << "</SYM>";
+      return;
+    }
+
+    case Stmt::MemberExprClass: {
+      const MemberExpr *ME = cast<MemberExpr>(E);
+      const FieldDecl *FD = dyn_cast<FieldDecl>(ME->getMemberDecl());
+      if (FD && FD->isAnonymousStructOrUnion()) {
+        printExpr(ME->getBase());
+        return;
+      }
+      OS << "<SYM K=\"field\"";
+      printAttr(OS, "N", ME->getMemberNameInfo().getAsString());
+      OS << '>';
+      printExpr(ME->getBase());
+      OS << "</SYM>";
+      return;
+    }
+
+    case Stmt::UnaryExprOrTypeTraitExprClass: {
+      // printed as a call to sizeof or alignof, like the text form
+      const UnaryExprOrTypeTraitExpr *UE = cast<UnaryExprOrTypeTraitExpr>(E);
+      StringRef Name;
+      switch (UE->getKind()) {
+        case UETT_SizeOf: Name = "sizeof"; break;
+        case UETT_AlignOf: Name = "alignof"; break;
+        default: break;
+      }
+      if (Name.empty())
+        break;
+      OS << "<SYM K=\"call\"";
+      printAttr(OS, "N", Name);
+      OS << '>';
+      if (UE->isArgumentType())
+        ::printText(OS, UE->getArgumentType().getAsString());
+      else
+        printStructure(UE->getArgumentExpr());
+      OS << "</SYM>";
+      return;
+    }
+
+    case Stmt::BinaryOperatorClass:
+    case Stmt::CompoundAssignOperatorClass: {
+      const BinaryOperator *BO = cast<BinaryOperator>(E);
+      OS << "<SYM K=\"binop\"";
+      printAttr(OS, "OP", BO->getOpcodeStr());
+      OS << '>';
+      printExpr(BO->getLHS());
+      printExpr(BO->getRHS());
+      OS << "</SYM>";
+      return;
+    }
+
+    default:
+      break;
+  }
+  printText(E);
+}
+
+void SymTreePrinter::printSVal(SVal V) {
+  if (Optional<nonloc::ConcreteInt> CI = V.getAs<nonloc::ConcreteInt>()) {
+    printInt(OS, CI->getValue());
+    return;
+  }
+  if (Optional<loc::ConcreteInt> CI = V.getAs<loc::ConcreteInt>()) {
+    // printed as an unsigned value
+    printInt(OS, llvm::APSInt(CI->getValue(), true));
+    return;
+  }
+  if (Optional<nonloc::SymbolVal> SV = V.getAs<nonloc::SymbolVal>()) {
+    printSymbol(SV->getSymbol());
+    return;
+  }
+  if (Optional<nonloc::LocAsInteger> LI = V.getAs<nonloc::LocAsInteger>()) {
+    printSVal(LI->getLoc());
+    return;
+  }
+  if (Optional<nonloc::LazyCompoundVal> LCV =
+        V.getAs<nonloc::LazyCompoundVal>()) {
+    printRegion(LCV->getRegion());
+    return;
+  }
+  if (Optional<loc::MemRegionVal> MR = V.getAs<loc::MemRegionVal>()) {
+    printRegion(MR->getRegion());
+    return;
+  }
+  printDumpAsText(OS, V);
+}
+
+void SymTreePrinter::printSymbol(SymbolRef Sym) {
+  switch (Sym->getKind()) {
+    case SymExpr::SymIntKind: {
+      const SymIntExpr *SIE = cast<SymIntExpr>(Sym);
+      OS << "<SYM K=\"binop\"";
+      printAttr(OS, "OP", BinaryOperator::getOpcodeStr(SIE->getOpcode()));
+      OS << '>';
+      printSymbol(SIE->getLHS());
+      printInt(OS, SIE->getRHS());
+      OS << "</SYM>";
+      return;
+    }
+
+    case SymExpr::IntSymKind: {
+      const IntSymExpr *ISE = cast<IntSymExpr>(Sym);
+      OS << "<SYM K=\"binop\"";
+      printAttr(OS, "OP", BinaryOperator::getOpcodeStr(ISE->getOpcode()));
+      OS << '>';
+      printInt(OS, ISE->getLHS());
+      printSymbol(ISE->getRHS());
+      OS << "</SYM>";
+      return;
+    }
+
+    case SymExpr::SymSymKind: {
+      const SymSymExpr *SSE = cast<SymSymExpr>(Sym);
+      OS << "<SYM K=\"binop\"";
+      printAttr(OS, "OP", BinaryOperator::getOpcodeStr(SSE->getOpcode()));
+      OS << '>';
+      printSymbol(SSE->getLHS());
+      printSymbol(SSE->getRHS());
+      OS << "</SYM>";
+      return;
+    }
+
+    case SymExpr::CastSymbolKind:
+      printSymbol(cast<SymbolCast>(Sym)->getOperand());
+      return;
+
+    case SymExpr::ConjuredKind: {
+      // the expression in the state it was evaluated in
+      const SymbolConjured *SC = cast<SymbolConjured>(Sym);
+      const Expr *E = dyn_cast_or_null<Expr>(SC->getStmt());
+      if (!E || !SC->isPrintable())
+        break;
+      SymTreePrinter(OS, SC, false, Filter).printExpr(E);
+      return;
+    }
+
+    case SymExpr::DerivedKind: {
+      const SymbolDerived *SD = cast<SymbolDerived>(Sym);
+      if (!isa<SymbolConjured>(SD->getParentSymbol()))
+        break;
+      printRegion(SD->getRegion());
+      return;
+    }
+
+    case SymExpr::RegionValueKind:
+      printRegion(cast<SymbolRegionValue>(Sym)->getRegion());
+      return;
+
+    default:
+      break;
+  }
+  printDumpAsText(OS, *Sym);
+}
+
+void SymTreePrinter::printRegion(const MemRegion *R) {
+  switch (R->getKind()) {
+    case MemRegion::VarRegionKind:
+      OS << "<SYM K=\"id\"";
+      printAttr(OS, "N", cast<VarRegion>(R)->getDecl()->getNameAsString());
+      OS << "/>";
+      return;
+
+    case MemRegion::FunctionTextRegionKind:
+      OS << "<SYM K=\"id\"";
+      printAttr(OS, "N", cast<FunctionTextRegion>(R)->getDecl()
+                           ->getDeclName().getAsString());
+      OS << "/>";
+      return;
+
+    case MemRegion::CXXThisRegionKind:
+      OS << "<SYM K=\"id\" N=\"this\"/>";
+      return;
+
+    case MemRegion::FieldRegionKind: {
+      const FieldRegion *FR = cast<FieldRegion>(R);
+      const FieldDecl *FD = FR->getDecl();
+      OS << "<SYM K=\"field\"";
+      // XXX: if struct contains two different type of union, then fails.
+      printAttr(OS, "N", FD->isAnonymousStructOrUnion() ? "anon"
+                                                        : FD->getName());
+      OS << '>';
+      printRegion(FR->getSuperRegion());
+      OS << "</SYM>";
+      return;
+    }
+
+    case MemRegion::ElementRegionKind: {
+      const ElementRegion *ER = cast<ElementRegion>(R);
+      ASTContext &Ctx = ER->getContext();
+      CharUnits Size = Ctx.getTypeSizeInChars(ER->getElementType());
+      if (ER->getIndex().isZeroConstant() || Size.getQuantity() == 0) {
+        printRegion(ER->getSuperRegion());
+        return;
+      }
+      OS << "<SYM K=\"array\">";
+      printRegion(ER->getSuperRegion());
+      printSVal(ER->getIndex());
+      OS << "</SYM>";
+      return;
+    }
+
+    case MemRegion::SymbolicRegionKind:
+      printSymbol(cast<SymbolicRegion>(R)->getSymbol());
+      return;
+
+    case MemRegion::StringRegionKind: {
+      std::string Str;
+      llvm::raw_string_ostream SS(Str);
+      cast<StringRegion>(R)->getStringLiteral()->outputString(SS);
+      OS << "<SYM K=\"str\"";
+      printAttr(OS, "V", SS.str());
+      OS << "/>";
+      return;
+    }
+
+    default:
+      break;
+  }
+  printDumpAsText(OS, *R);
+}
+
+void SymTreePrinter::printConstraint(
+    SymbolRef Sym, ArrayRef<std::pair<llvm::APSInt, llvm::APSInt> > Ranges) {
+  OS << "<SYM K=\"constraint\">";
+  printSymbol(Sym);
+  for (const std::pair<llvm::APSInt, llvm::APSInt> &R : Ranges) {
+    OS << "<RANGE FROM=\"" << R.first.toString(10)
+       << "\" TO=\"" << R.second.toString(10) << "\"/>";
+  }
+  OS << "</SYM>";
+}
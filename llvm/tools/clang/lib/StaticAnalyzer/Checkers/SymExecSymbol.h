@@ -0,0 +1,86 @@
+//=== SymExecSymbol.h - Structured symbols for SymExecExtractor --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Declares SymTreePrinter, which writes calls and path conditions as
+// structured symbol trees instead of C-like text. The trees are XML elements
+// read by analyzer/apisan/parse/symbol.py:
+//
+//   <SYM K="call" N="callee">argument...</SYM>
+//   <SYM K="int" V="-1"/>
+//   <SYM K="str" V="&quot;string literal&quot;"/>
+//   <SYM K="id" N="name"/>
+//   <SYM K="field" N="member">base</SYM>
+//   <SYM K="array">base index</SYM>
+//   <SYM K="binop" OP="==">lhs rhs</SYM>
+//   <SYM K="constraint">symbol <RANGE FROM="0" TO="0"/>...</SYM>
+//   <SYM K="text" V="..."/>
+//
+// sizeof and alignof are written as calls to "sizeof" and "alignof" whose
+// argument is the operand (or its type as "text"), not as their value.
+//
+// Anything without a structured form is written as "text", the way the
+// analyzer prints it, so that no event is lost.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_STATICANALYZER_CHECKERS_SYMEXECSYMBOL_H
+#define LLVM_CLANG_LIB_STATICANALYZER_CHECKERS_SYMEXECSYMBOL_H
+
+#include "clang/StaticAnalyzer/Core/PathSensitive/ProgramState.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/SVals.h"
+#include "llvm/ADT/APSInt.h"
+#include "llvm/ADT/ArrayRef.h"
+
+namespace clang {
+namespace ento {
+
+class SymExecFilter;
+
+class SymTreePrinter {
+public:
+  /// \p LValue is the same as in AsStmtPrinter: conjured symbols of
+  /// expressions are expanded rather than printed as values. Calls to the
+  /// callees \p Filter says "noargs" for are printed without arguments.
+  SymTreePrinter(raw_ostream &OS, ProgramStateRef State,
+                 const LocationContext *LCtx, bool LValue,
+                 SymExecFilter *Filter = nullptr)
+    : OS(OS), State(State), LCtx(LCtx), Conjured(nullptr), LValue(LValue),
+      Filter(Filter) {}
+
+  /// Prints with the values recorded in the conjured symbol \p Sym.
+  SymTreePrinter(raw_ostream &OS, const SymbolConjured *Sym, bool LValue,
+                 SymExecFilter *Filter = nullptr)
+    : OS(OS), LCtx(Sym->getLocationContext()), Conjured(Sym),
+      LValue(LValue), Filter(Filter) {}
+
+  void printExpr(const Expr *E);
+  void printSVal(SVal V);
+  void printSymbol(SymbolRef Sym);
+  void printRegion(const MemRegion *R);
+  void printConstraint(SymbolRef Sym,
+                       ArrayRef<std::pair<llvm::APSInt, llvm::APSInt> > Ranges);
+
+private:
+  SVal getValue(const Expr *E) const;
+  bool tryToPrintValue(const Expr *E);
+  void printStructure(const Expr *E);
+  void printText(const Expr *E);
+
+  raw_ostream &OS;
+  ProgramStateRef State;
+  const LocationContext *LCtx;
+  const SymbolConjured *Conjured;
+  bool LValue;
+  SymExecFilter *Filter;
+};
+
+} // end namespace ento
+} // end namespace clang
+
+#endif
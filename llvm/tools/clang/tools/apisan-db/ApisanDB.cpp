@@ -0,0 +1,574 @@
+//===-- ApisanDB.cpp - Native reader of the symbolic-context database -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Scans the reports of an xml database file (.as) into the arrays of
+// ApisanDBArrays. The scanner knows the subset of xml that the extractor
+// writes; anything else fails the whole file, which is then left to the
+// Python reader (analyzer/apisan/parse/explorer.py).
+//
+//===----------------------------------------------------------------------===//
+
+#include "ApisanDB.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+struct ApisanDB {
+  std::unique_ptr<MemoryBuffer> Buffer;
+  std::string Error;
+
+  std::vector<uint8_t> Kinds;
+  std::vector<uint8_t> Flags;
+  std::vector<uint32_t> Parents;
+  std::vector<uint32_t> ChildStart;
+  std::vector<uint32_t> Children;
+  std::vector<uint32_t> Codes;
+  std::vector<uint32_t> Texts;
+  std::vector<uint32_t> RangeStart;
+  std::vector<uint64_t> Ranges;
+  std::vector<uint8_t> RangeSigns;
+
+  StringMap<uint32_t> StringIDs;
+  std::vector<uint64_t> StringOffsets;
+  std::vector<uint32_t> StringSizes;
+
+  std::vector<uint32_t> RootStart;
+  std::vector<uint32_t> Roots;
+  std::vector<uint64_t> Budgets;
+  std::vector<uint8_t> HasBudget;
+
+  ApisanDBArrays Arrays;
+};
+
+namespace {
+
+const char BeginSig[] = "@SYM_EXEC_EXTRACTOR_BEGIN";
+const char EndSig[] = "@SYM_EXEC_EXTRACTOR_END";
+
+// Names of SymExecBudget::Limit, by bit
+const char *const LimitNames[] = { "nodes", "time", "blocks", "aborted" };
+
+struct Tag {
+  StringRef Name;
+  StringRef Attrs;
+  bool Closing;
+  bool SelfClosing;
+};
+
+struct Range {
+  uint64_t From;
+  uint64_t To;
+  uint8_t Signs;
+};
+
+/// \brief A <NODE> whose end has not been read yet.
+struct OpenNode {
+  OpenNode() : HasEvent(false), Kind(APISAN_NODE_NONE), Flags(0),
+               Code(APISAN_NONE), Text(APISAN_NONE) {}
+
+  StringRef ID;
+  bool HasEvent;
+  uint8_t Kind;
+  uint8_t Flags;
+  uint32_t Code;
+  uint32_t Text;
+  SmallVector<Range, 2> Ranges;
+  SmallVector<uint32_t, 4> Children;
+};
+
+/// \brief Returns the value of attribute \p Name in \p Attrs, or an empty
+/// string.
+StringRef getAttr(StringRef Attrs, StringRef Name) {
+  while (true) {
+    Attrs = Attrs.ltrim();
+    size_t Eq = Attrs.find('=');
+    if (Eq == StringRef::npos || Attrs.size() < Eq + 2 || Attrs[Eq + 1] != '"')
+      return StringRef();
+    size_t End = Attrs.find('"', Eq + 2);
+    if (End == StringRef::npos)
+      return StringRef();
+    if (Attrs.substr(0, Eq).rtrim() == Name)
+      return Attrs.slice(Eq + 2, End);
+    Attrs = Attrs.substr(End + 1);
+  }
+}
+
+/// \brief Reads the tag that follows \p Pos in \p Text, skipping white
+/// space.
+bool lexTag(StringRef Text, size_t &Pos, Tag &T) {
+  size_t Start = Text.find_first_not_of(" \t\r\n", Pos);
+  if (Start == StringRef::npos || Text[Start] != '<')
+    return false;
+  size_t End = Text.find('>', Start);
+  if (End == StringRef::npos)
+    return false;
+  StringRef Inner = Text.slice(Start + 1, End);
+  T.Closing = Inner.startswith("/");
+  if (T.Closing)
+    Inner = Inner.substr(1);
+  T.SelfClosing = Inner.endswith("/");
+  if (T.SelfClosing)
+    Inner = Inner.drop_back();
+  size_t NameEnd = Inner.find_first_of(" \t\r\n");
+  T.Name = Inner.substr(0, NameEnd);
+  T.Attrs = NameEnd == StringRef::npos ? StringRef() : Inner.substr(NameEnd);
+  Pos = End + 1;
+  return true;
+}
+
+/// \brief Parses a decimal integer the way analyzer/apisan/parse/sparser.py
+/// does (an optional minus, then digits), into its sign and magnitude.
+bool parseInt(StringRef S, uint64_t &Value, bool &Negative) {
+  S = S.trim(" \t");
+  Negative = S.startswith("-");
+  if (Negative)
+    S = S.substr(1).ltrim(" \t");
+  if (S.empty() || (S.size() > 1 && S[0] == '0') ||
+      S.find_first_not_of("0123456789") != StringRef::npos)
+    return false;
+  return !S.getAsInteger(10, Value);
+}
+
+bool parseRange(StringRef From, StringRef To, Range &R) {
+  bool NegFrom, NegTo;
+  if (!parseInt(From, R.From, NegFrom) || !parseInt(To, R.To, NegTo))
+    return false;
+  R.Signs = (NegFrom ? APISAN_RANGE_NEGATIVE_FROM : 0) |
+            (NegTo ? APISAN_RANGE_NEGATIVE_TO : 0);
+  return true;
+}
+
+class ReportScanner {
+public:
+  ReportScanner(ApisanDB &DB, StringRef Body) : DB(DB), Body(Body), Pos(0) {}
+
+  /// \brief Appends the nodes and the roots of the report to the arrays.
+  bool scan();
+
+private:
+  bool error(const Twine &Msg);
+  bool nextTag(Tag &T);
+  bool readContent(const Tag &T, StringRef &Content);
+  bool readEvent(OpenNode &N);
+  bool readBudget(StringRef Attrs, bool &HasBudget, uint64_t *Budget);
+  void splitCond(OpenNode &N, StringRef Cond);
+  bool splitTextCond(OpenNode &N, StringRef Cond);
+  bool splitSymCond(OpenNode &N, StringRef Cond);
+  uint32_t intern(StringRef S);
+  void addChild(uint32_t Index);
+  void closeNode();
+
+  ApisanDB &DB;
+  StringRef Body;
+  size_t Pos;
+
+  std::vector<OpenNode> Stack;
+  SmallVector<uint32_t, 16> Roots;
+  // nodes emitted with an ID, by ID
+  StringMap<uint32_t> Shared;
+};
+
+} // end anonymous namespace
+
+bool ReportScanner::error(const Twine &Msg) {
+  uint64_t Offset = Body.data() + Pos - DB.Buffer->getBufferStart();
+  DB.Error = (Msg + " at offset " + Twine(Offset)).str();
+  return false;
+}
+
+bool ReportScanner::nextTag(Tag &T) {
+  if (lexTag(Body, Pos, T))
+    return true;
+  Pos = std::min(Body.find_first_not_of(" \t\r\n", Pos), Body.size());
+  return error("expected a tag");
+}
+
+bool ReportScanner::readContent(const Tag &T, StringRef &Content) {
+  if (T.SelfClosing) {
+    Content = StringRef();
+    return true;
+  }
+  SmallString<16> Close("</");
+  Close += T.Name;
+  Close += ">";
+  size_t End = Body.find(Close, Pos);
+  if (End == StringRef::npos)
+    return error("unterminated <" + T.Name + ">");
+  Content = Body.slice(Pos, End);
+  Pos = End + Close.size();
+  return true;
+}
+
+uint32_t ReportScanner::intern(StringRef S) {
+  // as the text of an empty element, which is None in Python
+  if (S.empty())
+    return APISAN_NONE;
+  auto Result = DB.StringIDs.insert(std::make_pair(S, DB.StringSizes.size()));
+  if (Result.second) {
+    DB.StringOffsets.push_back(S.data() - DB.Buffer->getBufferStart());
+    DB.StringSizes.push_back(S.size());
+  }
+  return Result.first->second;
+}
+
+bool ReportScanner::readEvent(OpenNode &N) {
+  Tag T;
+  StringRef Kind, Code, Text;
+  bool HasCode = false, HasText = false;
+  StringRef TextTag;
+
+  while (true) {
+    if (!nextTag(T))
+      return false;
+    if (T.Name == "EVENT" && T.Closing)
+      break;
+    if (T.Closing)
+      return error("unexpected </" + T.Name + ">");
+
+    StringRef Content;
+    if (!readContent(T, Content))
+      return false;
+    if (T.Name == "KIND") {
+      Kind = Content;
+    } else if (T.Name == "CODE") {
+      Code = Content;
+      HasCode = true;
+    } else if (T.Name == "CALL" || T.Name == "COND" || T.Name == "REASON") {
+      Text = Content;
+      TextTag = T.Name;
+      HasText = true;
+    } else {
+      return error("unsupported <" + T.Name + ">");
+    }
+  }
+
+  N.HasEvent = true;
+  N.Kind = StringSwitch<uint8_t>(Kind)
+    .Case("@LOG_CALL", APISAN_NODE_CALL)
+    .Case("@LOG_ASSUME", APISAN_NODE_ASSUME)
+    .Case("@LOG_EOP", APISAN_NODE_EOP)
+    .Case("@LOG_TRUNCATED", APISAN_NODE_TRUNCATED)
+    .Default(APISAN_NODE_NONE);
+
+  // the fields each kind of event may have, as in event.py
+  StringRef Expected;
+  switch (N.Kind) {
+    case APISAN_NODE_CALL:
+      Expected = "CALL";
+      break;
+    case APISAN_NODE_ASSUME:
+      Expected = "COND";
+      break;
+    case APISAN_NODE_TRUNCATED:
+      Expected = "REASON";
+      break;
+    case APISAN_NODE_EOP:
+      break;
+    default:
+      return error("unsupported event kind '" + Kind + "'");
+  }
+  if ((HasCode && N.Kind != APISAN_NODE_CALL) ||
+      (HasText && TextTag != Expected))
+    return error("unexpected field of " + Kind);
+
+  N.Code = intern(Code);
+  if (N.Kind == APISAN_NODE_ASSUME)
+    splitCond(N, Text);
+  else
+    N.Text = intern(Text);
+  return true;
+}
+
+void ReportScanner::splitCond(OpenNode &N, StringRef Cond) {
+  // the Python reader parses a constrained symbol once, whatever its ranges
+  if (Cond.ltrim().startswith("<") ? splitSymCond(N, Cond.trim())
+                                   : splitTextCond(N, Cond)) {
+    N.Flags |= APISAN_NODE_CONSTRAINT;
+    return;
+  }
+  N.Ranges.clear();
+  N.Text = intern(Cond);
+}
+
+bool ReportScanner::splitTextCond(OpenNode &N, StringRef Cond) {
+  // sym@={ [from, to], ... }, without entities to decode
+  size_t Op = Cond.rfind("@=");
+  if (Op == StringRef::npos || Cond.find('&') != StringRef::npos)
+    return false;
+  StringRef Rest = Cond.substr(Op + 2).trim(" \t");
+  if (!Rest.startswith("{") || !Rest.endswith("}"))
+    return false;
+  Rest = Rest.slice(1, Rest.size() - 1);
+
+  while (true) {
+    Rest = Rest.ltrim(" \t");
+    if (!Rest.startswith("["))
+      return false;
+    size_t Comma = Rest.find(',');
+    size_t Close = Rest.find(']');
+    if (Comma == StringRef::npos || Close == StringRef::npos || Close < Comma)
+      return false;
+    Range R;
+    if (!parseRange(Rest.slice(1, Comma), Rest.slice(Comma + 1, Close), R))
+      return false;
+    N.Ranges.push_back(R);
+    Rest = Rest.substr(Close + 1).ltrim(" \t");
+    if (!Rest.startswith(","))
+      break;
+    Rest = Rest.substr(1);
+  }
+
+  if (!Rest.empty())
+    return false;
+  N.Text = intern(Cond.substr(0, Op));
+  return N.Text != APISAN_NONE;
+}
+
+bool ReportScanner::splitSymCond(OpenNode &N, StringRef Cond) {
+  // <SYM K="constraint"><SYM ...>...</SYM><RANGE FROM=".." TO=".."/>...</SYM>
+  size_t Pos = 0;
+  Tag T;
+  if (!lexTag(Cond, Pos, T) || T.Name != "SYM" || T.Closing ||
+      T.SelfClosing || getAttr(T.Attrs, "K") != "constraint")
+    return false;
+
+  size_t Start = Cond.find('<', Pos);
+  unsigned Depth = 0;
+  do {
+    if (!lexTag(Cond, Pos, T) || T.Name != "SYM" || (T.Closing && !Depth))
+      return false;
+    if (T.Closing)
+      --Depth;
+    else if (!T.SelfClosing)
+      ++Depth;
+  } while (Depth);
+  StringRef Symbol = Cond.slice(Start, Pos);
+
+  while (lexTag(Cond, Pos, T) && T.Name == "RANGE" && T.SelfClosing) {
+    Range R;
+    if (!parseRange(getAttr(T.Attrs, "FROM"), getAttr(T.Attrs, "TO"), R))
+      return false;
+    N.Ranges.push_back(R);
+  }
+  if (T.Name != "SYM" || !T.Closing ||
+      Cond.find_first_not_of(" \t\r\n", Pos) != StringRef::npos)
+    return false;
+  N.Text = intern(Symbol);
+  return true;
+}
+
+bool ReportScanner::readBudget(StringRef Attrs, bool &HasBudget,
+                               uint64_t *Budget) {
+  // as explorer.get_budget(): nodes, time, limits, frontier
+  StringRef Nodes = getAttr(Attrs, "NODES");
+  if (HasBudget || Nodes.empty())
+    return true;
+  StringRef Time = getAttr(Attrs, "TIME");
+  StringRef Frontier = getAttr(Attrs, "FRONTIER");
+  Budget[1] = 0;
+  if (Nodes.getAsInteger(10, Budget[0]) ||
+      (!Time.empty() && Time.getAsInteger(10, Budget[1])) ||
+      (!Frontier.empty() && Frontier.getAsInteger(10, Budget[3])))
+    return error("bad budget");
+
+  Budget[2] = 0;
+  SmallVector<StringRef, 4> Limits;
+  StringRef LimitList = getAttr(Attrs, "LIMITS");
+  if (!LimitList.empty())
+    LimitList.split(Limits, ",");
+  for (StringRef Limit : Limits) {
+    unsigned Bit = 0;
+    while (Bit < array_lengthof(LimitNames) && Limit != LimitNames[Bit])
+      ++Bit;
+    if (Bit == array_lengthof(LimitNames))
+      return error("unknown limit '" + Limit + "'");
+    Budget[2] |= 1 << Bit;
+  }
+  HasBudget = true;
+  return true;
+}
+
+void ReportScanner::addChild(uint32_t Index) {
+  if (Stack.empty())
+    Roots.push_back(Index);
+  else
+    Stack.back().Children.push_back(Index);
+}
+
+void ReportScanner::closeNode() {
+  OpenNode &N = Stack.back();
+  uint32_t Index = DB.Kinds.size();
+
+  DB.Kinds.push_back(N.Kind);
+  DB.Flags.push_back(N.Flags);
+  DB.Parents.push_back(APISAN_NONE);
+  DB.Codes.push_back(N.Code);
+  DB.Texts.push_back(N.Text);
+  // a shared node keeps its last parent, as ExecNode does
+  for (uint32_t Child : N.Children) {
+    DB.Parents[Child] = Index;
+    DB.Children.push_back(Child);
+  }
+  DB.ChildStart.push_back(DB.Children.size());
+  for (const Range &R : N.Ranges) {
+    DB.Ranges.push_back(R.From);
+    DB.Ranges.push_back(R.To);
+    DB.RangeSigns.push_back(R.Signs);
+  }
+  DB.RangeStart.push_back(DB.RangeSigns.size());
+
+  if (!N.ID.empty())
+    Shared[N.ID] = Index;
+  Stack.pop_back();
+  addChild(Index);
+}
+
+bool ReportScanner::scan() {
+  Tag T;
+  bool HasBudget = false;
+  uint64_t Budget[4] = { 0, 0, 0, 0 };
+
+  if (!nextTag(T) || T.Name != "TREE" || T.Closing)
+    return error("expected <TREE>");
+  if (!readBudget(T.Attrs, HasBudget, Budget))
+    return false;
+
+  bool Done = T.SelfClosing;
+  while (!Done) {
+    if (!nextTag(T))
+      return false;
+
+    if (T.Name == "NODE" && !T.Closing) {
+      Stack.push_back(OpenNode());
+      Stack.back().ID = getAttr(T.Attrs, "ID");
+      if (T.SelfClosing)
+        closeNode();
+    } else if (T.Name == "NODE") {
+      if (Stack.empty())
+        return error("unexpected </NODE>");
+      closeNode();
+    } else if (T.Name == "EVENT" && !T.Closing && !T.SelfClosing) {
+      if (Stack.empty() || Stack.back().HasEvent)
+        return error("unexpected <EVENT>");
+      if (!readEvent(Stack.back()))
+        return false;
+    } else if (T.Name == "REF" && T.SelfClosing) {
+      // back-reference to an already emitted node
+      auto I = Shared.find(getAttr(T.Attrs, "ID"));
+      if (I == Shared.end())
+        return error("unknown <REF>");
+      addChild(I->second);
+    } else if (T.Name == "BUDGET" && T.SelfClosing && Stack.empty()) {
+      if (!readBudget(T.Attrs, HasBudget, Budget))
+        return false;
+    } else if (T.Name == "TREE" && T.Closing && Stack.empty()) {
+      Done = true;
+    } else {
+      return error("unexpected <" + Twine(T.Closing ? "/" : "") + T.Name +
+                   ">");
+    }
+  }
+  if (Body.find_first_not_of(" \t\r\n", Pos) != StringRef::npos) {
+    Pos = Body.find_first_not_of(" \t\r\n", Pos);
+    return error("text after </TREE>");
+  }
+
+  DB.Roots.insert(DB.Roots.end(), Roots.begin(), Roots.end());
+  DB.RootStart.push_back(DB.Roots.size());
+  DB.Budgets.insert(DB.Budgets.end(), Budget, Budget + 4);
+  DB.HasBudget.push_back(HasBudget);
+  return true;
+}
+
+static bool readDatabase(ApisanDB &DB) {
+  StringRef Buf = DB.Buffer->getBuffer();
+  DB.ChildStart.push_back(0);
+  DB.RangeStart.push_back(0);
+  DB.RootStart.push_back(0);
+
+  // as explorer.iter_reports(): a report runs from a line starting with
+  // BeginSig to one starting with EndSig; a report without its end is lost
+  const char *Body = nullptr;
+  for (size_t Pos = 0; Pos < Buf.size();) {
+    size_t End = Buf.find('\n', Pos);
+    StringRef Line = Buf.slice(Pos, End);
+    if (Line.startswith(BeginSig)) {
+      Body = Line.end() + (End == StringRef::npos ? 0 : 1);
+    } else if (Body && Line.startswith(EndSig)) {
+      ReportScanner Scanner(DB, StringRef(Body, Line.begin() - Body));
+      if (!Scanner.scan())
+        return false;
+      Body = nullptr;
+    }
+    if (End == StringRef::npos)
+      break;
+    Pos = End + 1;
+  }
+  return true;
+}
+
+ApisanDB *apisan_db_open(const char *Path) {
+  ApisanDB *DB = new ApisanDB();
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+    MemoryBuffer::getFile(Path, -1, /*RequiresNullTerminator=*/false);
+  if (!Buffer) {
+    DB->Error = Buffer.getError().message();
+    return DB;
+  }
+  DB->Buffer = std::move(*Buffer);
+  if (!readDatabase(*DB))
+    return DB;
+
+  ApisanDBArrays &A = DB->Arrays;
+  A.NumNodes = DB->Kinds.size();
+  A.Kinds = DB->Kinds.data();
+  A.Flags = DB->Flags.data();
+  A.Parents = DB->Parents.data();
+  A.ChildStart = DB->ChildStart.data();
+  A.Children = DB->Children.data();
+  A.Codes = DB->Codes.data();
+  A.Texts = DB->Texts.data();
+  A.RangeStart = DB->RangeStart.data();
+  A.Ranges = DB->Ranges.data();
+  A.RangeSigns = DB->RangeSigns.data();
+  A.NumStrings = DB->StringSizes.size();
+  A.Base = DB->Buffer->getBufferStart();
+  A.StringOffsets = DB->StringOffsets.data();
+  A.StringSizes = DB->StringSizes.data();
+  A.NumReports = DB->HasBudget.size();
+  A.RootStart = DB->RootStart.data();
+  A.Roots = DB->Roots.data();
+  A.Budgets = DB->Budgets.data();
+  A.HasBudget = DB->HasBudget.data();
+  return DB;
+}
+
+const char *apisan_db_get_error(const ApisanDB *DB) {
+  return DB->Error.empty() ? nullptr : DB->Error.c_str();
+}
+
+const ApisanDBArrays *apisan_db_get_arrays(const ApisanDB *DB) {
+  return DB->Error.empty() ? &DB->Arrays : nullptr;
+}
+
+void apisan_db_close(ApisanDB *DB) {
+  delete DB;
+}
@@ -0,0 +1,115 @@
+/*===-- ApisanDB.h - Native reader of the symbolic-context database -*- C -*-===*\
+|*                                                                            *|
+|*                     The LLVM Compiler Infrastructure                       *|
+|*                                                                            *|
+|* This file is distributed under the University of Illinois Open Source      *|
+|* License. See LICENSE.TXT for details.                                      *|
+|*                                                                            *|
+|*===----------------------------------------------------------------------===*|
+|*                                                                            *|
+|* A C interface to read an xml database file (.as) written by                *|
+|* SymExecExtractor into flat arrays, for analyzer/apisan/parse/native.py.    *|
+|*                                                                            *|
+|* The file is memory-mapped and scanned once. Nodes are numbered in the      *|
+|* order their </NODE> is read, so children come before their parents, and    *|
+|* a node shared through <REF> is stored once. Calls, conditions, file names  *|
+|* and reasons are IDs of strings that point into the mapped file; a          *|
+|* structured symbol is the text of its <SYM> element, anything else is       *|
+|* element text with its entities left as written.                            *|
+|*                                                                            *|
+\*===----------------------------------------------------------------------===*/
+
+#ifndef LLVM_CLANG_TOOLS_APISAN_DB_APISANDB_H
+#define LLVM_CLANG_TOOLS_APISAN_DB_APISANDB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Kinds of nodes, the record kinds of the .asb format (SymExecDatabase.h) */
+enum ApisanNodeKind {
+  APISAN_NODE_CALL = 0,
+  APISAN_NODE_ASSUME = 1,
+  APISAN_NODE_EOP = 2,
+  APISAN_NODE_TRUNCATED = 3,
+  /* a <NODE> without <EVENT> */
+  APISAN_NODE_NONE = 4
+};
+
+/* Flags of a node */
+enum ApisanNodeFlags {
+  /* the condition is split into the string of its constrained symbol and
+     its ranges */
+  APISAN_NODE_CONSTRAINT = 1
+};
+
+/* Signs of a range, the bounds of which are stored as magnitudes */
+enum ApisanRangeSigns {
+  APISAN_RANGE_NEGATIVE_FROM = 1,
+  APISAN_RANGE_NEGATIVE_TO = 2
+};
+
+/* Missing parent or string */
+#define APISAN_NONE 0xffffffffu
+
+typedef struct ApisanDB ApisanDB;
+
+typedef struct {
+  uint32_t NumNodes;
+  /* ApisanNodeKind, by node */
+  const uint8_t *Kinds;
+  /* ApisanNodeFlags, by node */
+  const uint8_t *Flags;
+  /* last parent read, or APISAN_NONE */
+  const uint32_t *Parents;
+  /* children of node N are Children[ChildStart[N]..ChildStart[N + 1]) */
+  const uint32_t *ChildStart;
+  const uint32_t *Children;
+  /* <CODE> of a call */
+  const uint32_t *Codes;
+  /* <CALL>, <COND> (or its constrained symbol) or <REASON> */
+  const uint32_t *Texts;
+  /* ranges of node N are Ranges[2 * RangeStart[N]..2 * RangeStart[N + 1]),
+     FROM and TO in turn, with the ApisanRangeSigns of range I in
+     RangeSigns[I] */
+  const uint32_t *RangeStart;
+  const uint64_t *Ranges;
+  const uint8_t *RangeSigns;
+
+  uint32_t NumStrings;
+  const char *Base;
+  /* string S is Base[StringOffsets[S]..StringOffsets[S] + StringSizes[S]) */
+  const uint64_t *StringOffsets;
+  const uint32_t *StringSizes;
+
+  uint32_t NumReports;
+  /* roots of report R are Roots[RootStart[R]..RootStart[R + 1]) */
+  const uint32_t *RootStart;
+  const uint32_t *Roots;
+  /* nodes, milliseconds, limits (SymExecBudget::Limit) and frontier of
+     report R are Budgets[4 * R..4 * R + 4), if HasBudget[R] */
+  const uint64_t *Budgets;
+  const uint8_t *HasBudget;
+} ApisanDBArrays;
+
+/* Reads the database file at Path. Never returns null; check
+   apisan_db_get_error(). */
+ApisanDB *apisan_db_open(const char *Path);
+
+/* Returns why the file could not be read, or null. A file that cannot be
+   read here (a damaged report, events of older extractors) can still be
+   read by the Python reader. */
+const char *apisan_db_get_error(const ApisanDB *DB);
+
+/* Returns the arrays of the database, valid until apisan_db_close(). */
+const ApisanDBArrays *apisan_db_get_arrays(const ApisanDB *DB);
+
+void apisan_db_close(ApisanDB *DB);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
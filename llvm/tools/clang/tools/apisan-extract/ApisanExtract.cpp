@@ -0,0 +1,590 @@
+//===--- tools/apisan-extract/ApisanExtract.cpp - APISan extractor --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements apisan-extract, which runs the symbolic context
+//  extractor (alpha.unix.SymExecExtract) on the translation units of a
+//  compilation database, without re-running the build through scan-build.
+//
+//  Each translation unit is analyzed in a forked worker, so that a crash or
+//  a fatal error only loses that translation unit. The extractor writes the
+//  database of each translation unit under the output directory.
+//
+//  Translation units are started by their cost in the manifest of the last
+//  run, longest first, so that a large one does not start last and keep a
+//  single core busy at the end.
+//
+//  The manifest is also the journal of the run: a translation unit has a
+//  record only once its database is complete, so -resume skips those and
+//  continues an interrupted run. Workers may be capped with setrlimit, and a
+//  translation unit that ran out of memory or CPU time is retried with
+//  smaller analysis budgets.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
+#include "clang/StaticAnalyzer/Frontend/FrontendActions.h"
+#include "clang/Tooling/ArgumentsAdjusters.h"
+#include "clang/Tooling/JSONCompilationDatabase.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <map>
+#include <new>
+#include <thread>
+
+#ifdef LLVM_ON_UNIX
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace clang;
+using namespace clang::tooling;
+using namespace llvm;
+
+static cl::OptionCategory ExtractCategory("apisan-extract options");
+
+static cl::opt<std::string>
+BuildPath("p", cl::desc("Build path (containing compile_commands.json), "
+                        "or the compilation database itself"),
+          cl::Required, cl::cat(ExtractCategory));
+
+static cl::list<std::string>
+SourcePaths(cl::Positional,
+            cl::desc("[<source0> ... <sourceN>] (default: all files in the "
+                     "compilation database)"),
+            cl::ZeroOrMore, cl::cat(ExtractCategory));
+
+static cl::opt<std::string>
+OutputDir("o", cl::desc("Directory the databases are written to"),
+          cl::init("as-out"), cl::cat(ExtractCategory));
+
+static cl::opt<unsigned>
+Jobs("j", cl::desc("Number of translation units analyzed at once "
+                   "(default: number of cores)"),
+     cl::init(0), cl::cat(ExtractCategory));
+
+static cl::opt<unsigned>
+MemoryBudget("mem-budget",
+             cl::desc("Memory (in MB) the translation units analyzed at once "
+                      "may use, by their peak in the last run (default: no "
+                      "limit)"),
+             cl::init(0), cl::cat(ExtractCategory));
+
+static cl::opt<bool>
+Resume("resume", cl::desc("Skip the translation units that have a record in "
+                          "the manifest of the output directory"),
+       cl::cat(ExtractCategory));
+
+static cl::opt<unsigned>
+MaxMemory("max-mem", cl::desc("Address space (in MB) of a worker (default: "
+                              "no limit)"),
+          cl::init(0), cl::cat(ExtractCategory));
+
+static cl::opt<unsigned>
+MaxCPU("max-cpu", cl::desc("CPU time (in seconds) of a worker (default: no "
+                           "limit)"),
+       cl::init(0), cl::cat(ExtractCategory));
+
+static cl::opt<unsigned>
+Retries("retries", cl::desc("Number of times a translation unit that ran "
+                            "out of memory or CPU time is retried, halving "
+                            "max-nodes and max-time each time"),
+        cl::init(1), cl::cat(ExtractCategory));
+
+static cl::opt<std::string>
+OutputFormat("format", cl::desc("Database format: xml or asb"),
+             cl::init("xml"), cl::cat(ExtractCategory));
+
+static cl::opt<bool>
+Dedup("dedup", cl::desc("Analyze each function defined in a header in one "
+                        "translation unit only"),
+      cl::cat(ExtractCategory));
+
+static cl::list<std::string>
+EnabledCheckers("enable-checker", cl::desc("Enable an analyzer checker"),
+                cl::ZeroOrMore, cl::cat(ExtractCategory));
+
+static cl::list<std::string>
+DisabledCheckers("disable-checker", cl::desc("Disable an analyzer checker"),
+                 cl::ZeroOrMore, cl::cat(ExtractCategory));
+
+static cl::list<std::string>
+AnalyzerConfigs("analyzer-config",
+                cl::desc("Analyzer option, as <option>=<value>"),
+                cl::ZeroOrMore, cl::cat(ExtractCategory));
+
+static cl::list<std::string>
+ExtraArgs("extra-arg",
+          cl::desc("Additional argument to append to the compiler command "
+                   "line"),
+          cl::ZeroOrMore, cl::cat(ExtractCategory));
+
+// Key of the translation unit being extracted (see getTUKey)
+static std::string TUKey;
+// Number of times it failed before
+static unsigned Attempt;
+
+namespace {
+// Runs the analyzer with the extractor enabled and no path diagnostics, on
+// top of the options the driver derived from --analyze.
+class ExtractAction : public ento::AnalysisAction {
+protected:
+  std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
+                                                 StringRef InFile) override {
+    AnalyzerOptions &Opts = *CI.getAnalyzerOpts();
+    Opts.AnalysisDiagOpt = PD_NONE;
+    Opts.CheckersControlList.push_back(
+        std::make_pair("alpha.unix.SymExecExtract", true));
+    for (const std::string &Checker : EnabledCheckers)
+      Opts.CheckersControlList.push_back(std::make_pair(Checker, true));
+    for (const std::string &Checker : DisabledCheckers)
+      Opts.CheckersControlList.push_back(std::make_pair(Checker, false));
+
+    Opts.Config["apisan-output-dir"] = OutputDir;
+    Opts.Config["apisan-output-format"] = OutputFormat;
+    Opts.Config["apisan-tu-key"] = TUKey;
+    if (Dedup) {
+      // Workers claim header functions in a directory they all share
+      Opts.AnalyzeAll = true;
+      Opts.Config["apisan-dedup-dir"] = OutputDir + "/.dedup";
+    }
+    for (StringRef Config : AnalyzerConfigs) {
+      std::pair<StringRef, StringRef> KV = Config.split('=');
+      Opts.Config[KV.first] = KV.second;
+    }
+    if (Attempt) {
+      // The options cache what they read, so look at the raw values. An
+      // unlimited or default max-nodes is halved from the default budget.
+      unsigned MaxNodes = 0, MaxTime = 0;
+      StringRef(Opts.Config["max-nodes"]).getAsInteger(10, MaxNodes);
+      StringRef(Opts.Config["max-time"]).getAsInteger(10, MaxTime);
+      if (!MaxNodes)
+        MaxNodes = 150000;
+      Opts.Config["max-nodes"] = utostr(std::max(1u, MaxNodes >> Attempt));
+      if (MaxTime)
+        Opts.Config["max-time"] = utostr(std::max(1u, MaxTime >> Attempt));
+    }
+    return AnalysisAction::CreateASTConsumer(CI, InFile);
+  }
+};
+} // end anonymous namespace
+
+// The database of a translation unit is keyed by its compile commands, so
+// that files with the same name, or a file built twice with different
+// options, do not overwrite each other. Like ClangTool, look the file up by
+// its absolute path.
+static std::string getTUKey(const CompilationDatabase &Compilations,
+                            StringRef File) {
+  MD5 Hash;
+  for (const CompileCommand &Cmd :
+       Compilations.getCompileCommands(getAbsolutePath(File))) {
+    Hash.update(Cmd.Directory);
+    Hash.update(StringRef("", 1));
+    for (const std::string &Arg : Cmd.CommandLine) {
+      Hash.update(Arg);
+      Hash.update(StringRef("", 1));
+    }
+  }
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Hex;
+  MD5::stringifyResult(Result, Hex);
+  return Hex.str();
+}
+
+namespace {
+struct ExtractJob {
+  std::string File;
+  std::string Key;
+  // Wall time (in seconds) and peak memory (in KB) of the last run
+  double Time;
+  uint64_t MaxRSS;
+  bool Known;
+  // Number of times it failed before
+  unsigned Attempt;
+};
+} // end anonymous namespace
+
+// Returns a field of a manifest record as written by SymExecExtractor.
+// Strings are returned as written, escapes included.
+static StringRef getManifestField(StringRef Record, StringRef Name) {
+  std::string Tag = "\"" + Name.str() + "\": ";
+  size_t Pos = Record.find(Tag);
+  if (Pos == StringRef::npos)
+    return StringRef();
+  StringRef Value = Record.substr(Pos + Tag.size());
+  if (Value.startswith("\"")) {
+    size_t End = 1;
+    while (End < Value.size() && Value[End] != '"')
+      End += Value[End] == '\\' ? 2 : 1;
+    return Value.substr(1, End - 1);
+  }
+  return Value.substr(0, Value.find_first_of(",}"));
+}
+
+// Keeps the last record of each source file in the manifest, like the
+// checkers do, and removes the databases that no record refers to: those of
+// a source file whose options (and so its key) changed since, and the
+// temporary files of killed workers. No worker runs yet.
+static void compactManifest() {
+  std::string Path = OutputDir + "/manifest.jsonl";
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buf = MemoryBuffer::getFile(Path);
+  if (!Buf)
+    return;
+  SmallVector<StringRef, 0> Records;
+  (*Buf)->getBuffer().split(Records, "\n", -1, false);
+  StringMap<unsigned> Last;
+  for (unsigned i = 0, e = Records.size(); i != e; ++i) {
+    StringRef Source = getManifestField(Records[i], "source");
+    // Records cut short by a killed worker have no source
+    if (!Source.empty())
+      Last[Source] = i + 1;
+  }
+
+  std::string Compacted;
+  StringSet<> Files;
+  for (unsigned i = 0, e = Records.size(); i != e; ++i) {
+    if (Last.lookup(getManifestField(Records[i], "source")) != i + 1)
+      continue;
+    Compacted += Records[i];
+    Compacted += '\n';
+    Files.insert(getManifestField(Records[i], "file"));
+  }
+  if (Compacted != (*Buf)->getBuffer()) {
+    std::error_code EC;
+    {
+      raw_fd_ostream OS(Path + ".tmp", EC, sys::fs::F_None);
+      if (!EC)
+        OS << Compacted;
+    }
+    if (!EC)
+      EC = sys::fs::rename(Path + ".tmp", Path);
+    if (EC) {
+      errs() << "apisan-extract: " << Path << ": " << EC.message() << "\n";
+      return;
+    }
+  }
+
+  // Databases are <hh>/<key>.as[b], where hh starts the key
+  std::error_code EC;
+  for (sys::fs::directory_iterator D(OutputDir, EC), E; D != E && !EC;
+       D.increment(EC)) {
+    StringRef Dir = sys::path::filename(D->path());
+    if (Dir.size() != 2 || Dir.find_first_not_of("0123456789abcdef") !=
+                               StringRef::npos)
+      continue;
+    std::error_code FileEC;
+    for (sys::fs::directory_iterator F(D->path(), FileEC); F != E && !FileEC;
+         F.increment(FileEC)) {
+      StringRef Name = sys::path::filename(F->path());
+      SmallString<64> File(Dir);
+      sys::path::append(File, Name);
+      if (Name.startswith(Dir) && !Files.count(File))
+        sys::fs::remove(F->path());
+    }
+  }
+}
+
+// Orders the translation units by their cost in the manifest of the last
+// run. Units without a record (new ones, or ones that crashed) go first,
+// since they may be the large ones.
+static std::deque<ExtractJob>
+scheduleJobs(const CompilationDatabase &Compilations,
+             ArrayRef<std::string> Files) {
+  std::map<std::string, std::pair<double, uint64_t>> Costs;
+  uint64_t TotalRSS = 0;
+  if (ErrorOr<std::unique_ptr<MemoryBuffer>> Buf =
+          MemoryBuffer::getFile(OutputDir + "/manifest.jsonl")) {
+    SmallVector<StringRef, 0> Records;
+    (*Buf)->getBuffer().split(Records, "\n", -1, false);
+    for (StringRef Record : Records) {
+      unsigned long long MaxRSS = 0;
+      StringRef Key = getManifestField(Record, "key");
+      std::string TimeField = getManifestField(Record, "time");
+      char *End;
+      double Time = strtod(TimeField.c_str(), &End);
+      if (Key.empty() || TimeField.empty() || *End)
+        continue;
+      getManifestField(Record, "maxrss").getAsInteger(10, MaxRSS);
+      Costs[Key] = std::make_pair(Time, (uint64_t)MaxRSS);
+    }
+  }
+
+  std::deque<ExtractJob> Queue;
+  unsigned NumKnown = 0;
+  unsigned NumDone = 0;
+  for (const std::string &File : Files) {
+    ExtractJob J = { File, getTUKey(Compilations, File), 0, 0, false, 0 };
+    auto I = Costs.find(J.Key);
+    if (I != Costs.end() && Resume) {
+      ++NumDone;
+      continue;
+    }
+    if (I != Costs.end()) {
+      J.Time = I->second.first;
+      J.MaxRSS = I->second.second;
+      J.Known = true;
+      TotalRSS += J.MaxRSS;
+      ++NumKnown;
+    }
+    Queue.push_back(J);
+  }
+
+  // Units without a record are expected to take the average memory
+  for (ExtractJob &J : Queue)
+    if (!J.Known && NumKnown)
+      J.MaxRSS = TotalRSS / NumKnown;
+
+  if (NumDone)
+    outs() << "apisan-extract: " << NumDone << " of " << Files.size()
+           << " translation units were extracted before\n";
+
+  std::stable_sort(Queue.begin(), Queue.end(),
+                   [](const ExtractJob &A, const ExtractJob &B) {
+    if (A.Known != B.Known)
+      return !A.Known;
+    return A.Time > B.Time;
+  });
+  return Queue;
+}
+
+// Removes a directory and everything under it.
+static void removeTree(StringRef Path) {
+  std::error_code EC;
+  for (sys::fs::directory_iterator I(Path, EC), E; I != E && !EC;
+       I.increment(EC)) {
+    sys::fs::file_status Status;
+    if (!I->status(Status) && sys::fs::is_directory(Status))
+      removeTree(I->path());
+    else
+      sys::fs::remove(I->path());
+  }
+  sys::fs::remove(Path);
+}
+
+static int extract(const CompilationDatabase &Compilations,
+                   const ExtractJob &J) {
+  TUKey = J.Key;
+  Attempt = J.Attempt;
+  ClangTool Tool(Compilations, J.File);
+  Tool.clearArgumentsAdjusters();
+  Tool.appendArgumentsAdjuster(getClangStripOutputAdjuster());
+  Tool.appendArgumentsAdjuster(
+      getInsertArgumentAdjuster("--analyze", ArgumentInsertPosition::BEGIN));
+  if (!ExtraArgs.empty())
+    Tool.appendArgumentsAdjuster(
+        getInsertArgumentAdjuster(ExtraArgs, ArgumentInsertPosition::END));
+  return Tool.run(newFrontendActionFactory<ExtractAction>().get());
+}
+
+#ifdef LLVM_ON_UNIX
+typedef std::map<pid_t, const ExtractJob *> WorkerMap;
+
+// Exit status of a worker that failed to allocate memory (EX_TEMPFAIL).
+// Like a worker killed by a signal, e.g. at the CPU limit or by the OOM
+// killer, it is retried; a translation unit that does not compile is not.
+static const int ExitOutOfMemory = 75;
+
+static void exitOutOfMemory() {
+  // Nothing can be allocated here, so write to the descriptor directly
+  static const char Message[] = "apisan-extract: out of memory\n";
+  ssize_t Written = write(STDERR_FILENO, Message, sizeof(Message) - 1);
+  (void)Written;
+  _exit(ExitOutOfMemory);
+}
+
+// Caps the resources of a worker. The analysis is killed at the hard CPU
+// limit, or fails to allocate past the address space limit.
+static void setWorkerLimits() {
+  struct rlimit RL;
+  if (MaxMemory) {
+    RL.rlim_cur = RL.rlim_max = (rlim_t)MaxMemory << 20;
+    setrlimit(RLIMIT_AS, &RL);
+  }
+  if (MaxCPU) {
+    RL.rlim_cur = RL.rlim_max = MaxCPU;
+    setrlimit(RLIMIT_CPU, &RL);
+  }
+}
+
+namespace {
+enum WorkerStatus { WorkerSucceeded, WorkerFailed, WorkerOverBudget };
+} // end anonymous namespace
+
+// Waits for a worker and returns how it ended.
+static WorkerStatus waitForWorker(const WorkerMap &Workers, pid_t &Pid) {
+  int Status;
+  do {
+    Pid = waitpid(-1, &Status, 0);
+  } while (Pid == -1 && errno == EINTR);
+  if (Pid == -1) {
+    errs() << "apisan-extract: waitpid failed\n";
+    exit(1);
+  }
+
+  if (WIFEXITED(Status) && WEXITSTATUS(Status) == 0)
+    return WorkerSucceeded;
+  errs() << "apisan-extract: " << Workers.find(Pid)->second->File;
+  if (WIFSIGNALED(Status)) {
+    errs() << ": killed by signal " << WTERMSIG(Status) << "\n";
+    return WorkerOverBudget;
+  }
+  if (WEXITSTATUS(Status) == ExitOutOfMemory) {
+    errs() << ": out of memory\n";
+    return WorkerOverBudget;
+  }
+  errs() << ": failed with exit status " << WEXITSTATUS(Status) << "\n";
+  return WorkerFailed;
+}
+
+// Waits for a worker. A translation unit over its budget is queued again,
+// to be analyzed with smaller budgets, until it runs out of retries.
+static void reapWorker(WorkerMap &Workers, std::deque<ExtractJob> &Queue,
+                       uint64_t &InUse, unsigned &Failed) {
+  pid_t Pid;
+  WorkerStatus Status = waitForWorker(Workers, Pid);
+  const ExtractJob &J = *Workers[Pid];
+  InUse -= J.MaxRSS;
+  if (Status == WorkerOverBudget && J.Attempt < Retries) {
+    errs() << "apisan-extract: " << J.File
+           << ": retrying with smaller budgets\n";
+    ExtractJob Retry = J;
+    ++Retry.Attempt;
+    Queue.push_back(Retry);
+  } else if (Status != WorkerSucceeded)
+    ++Failed;
+  Workers.erase(Pid);
+}
+
+// Starts the next translation unit whenever a worker is free, as long as
+// the expected memory of the running ones stays within MemoryBudget. A
+// translation unit over the budget by itself runs alone.
+static unsigned extractAll(const CompilationDatabase &Compilations,
+                           std::deque<ExtractJob> Queue) {
+  WorkerMap Workers;
+  uint64_t Budget = (uint64_t)MemoryBudget << 10;
+  uint64_t InUse = 0;
+  unsigned Failed = 0;
+
+  // Retries are appended to Queue, which keeps the jobs of Workers in place
+  size_t Next = 0;
+  while (Next != Queue.size() || !Workers.empty()) {
+    if (Next == Queue.size()) {
+      reapWorker(Workers, Queue, InUse, Failed);
+      continue;
+    }
+    const ExtractJob &J = Queue[Next];
+    if (!Workers.empty() &&
+        (Workers.size() >= Jobs || (Budget && InUse + J.MaxRSS > Budget))) {
+      reapWorker(Workers, Queue, InUse, Failed);
+      continue;
+    }
+
+    // Don't let the workers flush what is buffered here
+    outs().flush();
+    errs().flush();
+    pid_t Pid = fork();
+    if (Pid == -1) {
+      errs() << "apisan-extract: fork failed\n";
+      exit(1);
+    }
+    if (Pid == 0) {
+      setWorkerLimits();
+      std::set_new_handler(exitOutOfMemory);
+      _exit(extract(Compilations, J));
+    }
+    Workers[Pid] = &J;
+    InUse += J.MaxRSS;
+    ++Next;
+  }
+  return Failed;
+}
+#else
+// Without workers, running out of memory ends the whole run, so a failed
+// translation unit is one that does not compile and is not retried.
+static unsigned extractAll(const CompilationDatabase &Compilations,
+                           std::deque<ExtractJob> Queue) {
+  unsigned Failed = 0;
+  for (const ExtractJob &J : Queue) {
+    if (!extract(Compilations, J))
+      continue;
+    errs() << "apisan-extract: " << J.File << ": failed\n";
+    ++Failed;
+  }
+  return Failed;
+}
+#endif
+
+int main(int argc, const char **argv) {
+  llvm::sys::PrintStackTraceOnErrorSignal();
+  // Hide unrelated options.
+  StringMap<cl::Option*> Options;
+  cl::getRegisteredOptions(Options);
+  for (StringMap<cl::Option *>::iterator I = Options.begin(), E = Options.end();
+       I != E; ++I) {
+    if (I->second->Category != &ExtractCategory && I->first() != "help" &&
+        I->first() != "version")
+      I->second->setHiddenFlag(cl::ReallyHidden);
+  }
+  cl::ParseCommandLineOptions(argc, argv,
+      "Extracts symbolic contexts for APISan from a compilation database\n");
+
+  SmallString<128> DBPath(BuildPath);
+  if (sys::fs::is_directory(DBPath.str()))
+    sys::path::append(DBPath, "compile_commands.json");
+  std::string ErrorMessage;
+  std::unique_ptr<CompilationDatabase> Compilations(
+      JSONCompilationDatabase::loadFromFile(DBPath, ErrorMessage));
+  if (!Compilations) {
+    errs() << "apisan-extract: " << ErrorMessage << "\n";
+    return 1;
+  }
+
+  // Workers write the databases with paths relative to their own working
+  // directory, which the compilation database may change
+  SmallString<128> AbsOutputDir(OutputDir);
+  if (std::error_code EC = sys::fs::make_absolute(AbsOutputDir)) {
+    errs() << "apisan-extract: " << OutputDir << ": " << EC.message() << "\n";
+    return 1;
+  }
+  OutputDir = AbsOutputDir.str();
+
+  std::vector<std::string> Files(SourcePaths.begin(), SourcePaths.end());
+  if (Files.empty())
+    Files = Compilations->getAllFiles();
+  if (Jobs == 0)
+    Jobs = std::max(1u, std::thread::hardware_concurrency());
+  // Claims are kept by -resume only, whose earlier databases still hold the
+  // functions they claimed
+  if (Dedup && !Resume)
+    removeTree(OutputDir + "/.dedup");
+  compactManifest();
+
+  unsigned Failed =
+    extractAll(*Compilations, scheduleJobs(*Compilations, Files));
+  if (Failed) {
+    errs() << "apisan-extract: " << Failed << " of " << Files.size()
+           << " translation units failed\n";
+    return 1;
+  }
+  return 0;
+}
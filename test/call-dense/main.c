@@ -0,0 +1,73 @@
+/*
+ * Call-dense functions for timing the extractor: every call is reached on
+ * many paths and loop iterations, so most FN_CALL events render a call that
+ * was rendered before.
+ *
+ *   $ make bench
+ *
+ * analyzes this file with alpha.unix.SymExecExtract and prints its manifest
+ * record, whose wall time and peak RSS compare builds of the extractor.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+struct buf {
+  char *data;
+  size_t len;
+};
+
+extern int fetch(struct buf *b, int key);
+extern int check(const char *data, size_t len);
+extern void release(struct buf *b);
+extern void log_error(const char *msg, int code);
+
+int dense(struct buf *b, int n) {
+  int i, sum = 0;
+  for (i = 0; i < n; i++) {
+    int r = fetch(b, i);
+    if (r < 0) {
+      log_error("fetch", r);
+      continue;
+    }
+    if (check(b->data, b->len))
+      sum += r;
+    else
+      log_error("check", r);
+    if (strlen(b->data) > b->len)
+      release(b);
+    if (memcmp(b->data, "key", 3) == 0)
+      sum -= fetch(b, r);
+  }
+  return sum;
+}
+
+int dense_unrolled(struct buf *b) {
+  int sum = 0;
+  if (fetch(b, 0) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 1) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 2) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 3) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 4) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 5) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 6) > 0)
+    sum += check(b->data, b->len);
+  if (fetch(b, 7) > 0)
+    sum += check(b->data, b->len);
+  if (sum < 0)
+    log_error("sum", sum);
+  release(b);
+  return sum;
+}
+
+int main(void) {
+  struct buf b = { malloc(16), 16 };
+  int sum = dense(&b, 16) + dense_unrolled(&b);
+  free(b.data);
+  return sum;
+}